@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+#
+# Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+# provided that the above copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+# IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+# WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+"""Compares wigwag_standalone_benchmarks JSON results (--json) against a baseline.
+
+Samples of the same metric from several result files are pooled, so a baseline may consist of several runs.
+A metric is reported as changed only if its median moved by more than both the threshold and the noise
+(twice the combined standard deviation of the baseline and the current samples).
+"""
+
+import argparse
+import fnmatch
+import json
+import math
+import statistics
+import sys
+
+
+UNIT_LABELS = {'ns': 'ns', 'bytes': 'B'}
+
+
+def load_samples(filenames):
+    samples = {}
+    units = {}
+    for filename in filenames:
+        with open(filename) as f:
+            results = json.load(f)
+        for benchmark in results['benchmarks']:
+            for m in benchmark['measurements']:
+                key = '{}[{}]'.format(benchmark['id'], m['name'])
+                samples.setdefault(key, []).extend(m['samples'])
+                units[key] = UNIT_LABELS.get(m['unit'], m['unit'])
+    return samples, units
+
+
+def stddev(values):
+    return statistics.stdev(values) if len(values) > 1 else 0.0
+
+
+def compare(baseline, current, threshold):
+    base_median = statistics.median(baseline)
+    cur_median = statistics.median(current)
+    if base_median == 0:
+        return cur_median, base_median, 0.0, 0.0, 'same' if cur_median == 0 else 'changed'
+
+    delta = (cur_median - base_median) / base_median
+    noise = 2 * math.sqrt(stddev(baseline) ** 2 + stddev(current) ** 2) / base_median
+    if abs(delta) <= max(threshold, noise):
+        verdict = 'same'
+    else:
+        verdict = 'regression' if delta > 0 else 'improvement'
+    return cur_median, base_median, delta, noise, verdict
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--baseline', nargs='+', required=True, help='baseline result files')
+    parser.add_argument('--current', nargs='+', required=True, help='current result files')
+    parser.add_argument('--metrics', nargs='+', default=['*'], help='measurement names to compare, e.g. invoke connect (default: all)')
+    parser.add_argument('--threshold', type=float, default=5.0, help='minimal relative change of the median to report, in percent (default: 5)')
+    parser.add_argument('--fail-on-regression', action='store_true', help='exit with 1 if any compared metric regressed')
+    args = parser.parse_args()
+
+    try:
+        baseline, units = load_samples(args.baseline)
+        current, _ = load_samples(args.current)
+    except (IOError, OSError, ValueError, KeyError) as ex:
+        print('Could not load the results: {}'.format(ex), file=sys.stderr)
+        return 2
+
+    def selected(key):
+        metric = key[key.rindex('[') + 1:-1]
+        return any(fnmatch.fnmatchcase(metric, m) for m in args.metrics)
+
+    keys = sorted(k for k in set(baseline) | set(current) if selected(k))
+    width = max([len(k) for k in keys] + [6])
+    print('{:<{w}}  {:>12}  {:>12}  {:>8}  {:>7}  {}'.format('metric', 'baseline', 'current', 'delta', 'noise', 'verdict', w=width))
+
+    compared = 0
+    regressions = 0
+    for key in keys:
+        if key not in baseline or key not in current:
+            print('{:<{w}}  {}'.format(key, 'only in baseline' if key in baseline else 'only in current', w=width))
+            continue
+
+        cur, base, delta, noise, verdict = compare(baseline[key], current[key], args.threshold / 100)
+        compared += 1
+        regressions += verdict == 'regression'
+        print('{:<{w}}  {:>9.4g} {:<2}  {:>9.4g} {:<2}  {:>+7.1f}%  {:>6.1f}%  {}'.format(
+            key, base, units[key], cur, units[key], delta * 100, noise * 100, verdict, w=width))
+
+    print('{} metrics compared, {} regressions'.format(compared, regressions))
+    return 1 if args.fail_on_regression and regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
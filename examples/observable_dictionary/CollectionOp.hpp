@@ -14,7 +14,8 @@
 enum class CollectionOp
 {
     ItemAdded,
-    ItemRemoved
+    ItemRemoved,
+    ItemUpdated
 };
 
 #endif
@@ -14,9 +14,23 @@
 #include <wigwag/listenable.hpp>
 #include <wigwag/signal.hpp>
 
+#include <vector>
+
 #include "CollectionOp.hpp"
 
 
+// ItemRemoved carries the removed value, ItemAdded and ItemUpdated carry the new one
+template < typename Key_, typename Value_ >
+struct ObservableDictionaryChange
+{
+    CollectionOp    Op;
+    Key_            Key;
+    Value_          Value;
+
+    ObservableDictionaryChange(CollectionOp op, const Key_& key, const Value_& value) : Op(op), Key(key), Value(value) { }
+};
+
+
 template < typename Key_, typename Value_ >
 struct IObservableDictionaryListener
 {
@@ -24,6 +38,27 @@ struct IObservableDictionaryListener
 
     virtual void OnItemAdded(const Key_&, const Value_&) = 0;
     virtual void OnItemRemoved(const Key_&, const Value_&) = 0;
+    virtual void OnItemUpdated(const Key_&, const Value_&) = 0;
+
+    // Gets every change set of the dictionary, a listener that handles a whole set at once should override it
+    virtual void OnChanged(const std::vector<ObservableDictionaryChange<Key_, Value_>>& changes)
+    {
+        for (const auto& c : changes)
+        {
+            switch (c.Op)
+            {
+            case CollectionOp::ItemAdded:
+                OnItemAdded(c.Key, c.Value);
+                break;
+            case CollectionOp::ItemRemoved:
+                OnItemRemoved(c.Key, c.Value);
+                break;
+            case CollectionOp::ItemUpdated:
+                OnItemUpdated(c.Key, c.Value);
+                break;
+            }
+        }
+    }
 };
 
 template < typename Key_, typename Value_ >
@@ -38,6 +73,7 @@ struct IObservableDictionary
     virtual std::recursive_mutex& SyncRoot() const = 0;
 
     virtual wigwag::signal_connector<void(CollectionOp, const Key_&, const Value_&)> OnChanged() const = 0;
+    virtual wigwag::signal_connector<void(const std::vector<ObservableDictionaryChange<Key_, Value_>>&)> OnChangeSet() const = 0;
     virtual wigwag::token AddListener(const IObservableDictionaryListenerPtr<Key_, Value_>& listener) const = 0;
 
     virtual int GetCount() const = 0;
@@ -52,6 +88,31 @@ struct IObservableDictionary
     virtual bool TryRemove(const Key_& key) = 0;
 
     virtual void Clear() = 0;
+
+    // The changes made between BeginUpdate and EndUpdate are reported when the outermost EndUpdate is called, as a single change
+    // set with one change per key. OnChanged handlers still get the changes one by one. A change made outside of a batch is a
+    // change set of its own. The dictionary stays locked by the calling thread until the batch ends
+    virtual void BeginUpdate() = 0;
+    virtual void EndUpdate() = 0;
+};
+
+
+template < typename Key_, typename Value_ >
+class ObservableDictionaryUpdateGuard
+{
+private:
+    IObservableDictionary<Key_, Value_>&    _dict;
+
+public:
+    explicit ObservableDictionaryUpdateGuard(IObservableDictionary<Key_, Value_>& dict)
+        : _dict(dict)
+    { _dict.BeginUpdate(); }
+
+    ~ObservableDictionaryUpdateGuard()
+    { _dict.EndUpdate(); }
+
+    ObservableDictionaryUpdateGuard(const ObservableDictionaryUpdateGuard&) = delete;
+    ObservableDictionaryUpdateGuard& operator = (const ObservableDictionaryUpdateGuard&) = delete;
 };
 
 
@@ -28,6 +28,11 @@ public:
     {
         Logger::Log(LogLevel::Info) << "DictListener::OnItemRemoved(" << k << ", " << v << ")";
     }
+
+    virtual void OnItemUpdated(const int& k, const std::string& v)
+    {
+        Logger::Log(LogLevel::Info) << "DictListener::OnItemUpdated(" << k << ", " << v << ")";
+    }
 };
 
 
@@ -76,12 +81,17 @@ int main()
                 case CollectionOp::ItemRemoved:
                     op_str = "ItemRemoved";
                     break;
+                case CollectionOp::ItemUpdated:
+                    op_str = "ItemUpdated";
+                    break;
                 default:
                     op_str = "Unknown";
                     break;
                 }
                 Logger::Log(LogLevel::Info) << "SignalHandler(" << op_str << ", " << k << ", " << v << ")";
             });
+        tp += dict->OnChangeSet().connect([](const std::vector<ObservableDictionaryChange<int, std::string>>& changes)
+            { Logger::Log(LogLevel::Info) << "ChangeSetHandler(" << changes.size() << " changes)"; });
 
         Random r;
 
@@ -96,6 +106,11 @@ int main()
                     Logger::Log(LogLevel::Info) << "=============";
                     dict->Set(i, r.GenerateString(6));
                     i = (i + 1) % size;
+
+                    // The listeners see only the final value of the key
+                    ObservableDictionaryUpdateGuard<int, std::string> g(*dict);
+                    dict->Set(i + size, r.GenerateString(6));
+                    dict->Set(i + size, r.GenerateString(6));
                 }
             });
 
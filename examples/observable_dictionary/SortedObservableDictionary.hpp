@@ -12,6 +12,7 @@
 
 
 #include <map>
+#include <vector>
 
 #include "../common/Signals.hpp"
 #include "IObservableDictionary.hpp"
@@ -24,18 +25,34 @@ class SortedObservableDictionary : public virtual IObservableDictionary<Key_, Va
     using Lock = std::lock_guard<Mutex>;
     using Listener = IObservableDictionaryListener<Key_, Value_>;
     using ListenerPtr = std::shared_ptr<Listener>;
+    using Change = ObservableDictionaryChange<Key_, Value_>;
+    using Changes = std::vector<Change>;
+
+    // The value a key had when the batch started, if any
+    struct OriginalEntry
+    {
+        bool        Exists;
+        Value_      Value;
+
+        OriginalEntry(bool exists, const Value_& value) : Exists(exists), Value(value) { }
+    };
 
 private:
     std::map<Key_, Value_>                                              _map;
     std::shared_ptr<Mutex>                                              _mutex;
     SharedRMutexSignal<void(CollectionOp, const Key_&, const Value_&)>  _onChanged;
+    SharedRMutexSignal<void(const Changes&)>                            _onChangeSet;
     SharedRMutexListenable<ListenerPtr>                                 _listenable;
+    int                                                                 _updateDepth;
+    std::map<Key_, OriginalEntry>                                       _originalEntries;
 
 public:
     SortedObservableDictionary()
         : _mutex(std::make_shared<Mutex>()),
           _onChanged(_mutex, [&](const typename decltype(_onChanged)::handler_type& h) { for (auto p : _map) h(CollectionOp::ItemAdded, p.first, p.second); }),
-          _listenable(_mutex, [&](const ListenerPtr& l) { for (auto p : _map) l->OnItemAdded(p.first, p.second); })
+          _onChangeSet(_mutex, [&](const typename decltype(_onChangeSet)::handler_type& h) { if (!_map.empty()) h(GetContents()); }),
+          _listenable(_mutex, [&](const ListenerPtr& l) { if (!_map.empty()) l->OnChanged(GetContents()); }),
+          _updateDepth(0)
     { }
 
     virtual std::recursive_mutex& SyncRoot() const
@@ -44,6 +61,9 @@ public:
     virtual wigwag::signal_connector<void(CollectionOp, const Key_&, const Value_&)> OnChanged() const
     { return _onChanged.connector(); }
 
+    virtual wigwag::signal_connector<void(const Changes&)> OnChangeSet() const
+    { return _onChangeSet.connector(); }
+
     virtual wigwag::token AddListener(const IObservableDictionaryListenerPtr<Key_, Value_>& listener) const
     { return _listenable.connect(listener); }
 
@@ -88,17 +108,26 @@ public:
     {
         Lock l(*_mutex);
         auto it = _map.find(key);
+        if (_updateDepth > 0)
+        {
+            RememberOriginalEntry(key, it);
+            if (it != _map.end())
+                it->second = value;
+            else
+                _map.insert({key, value});
+            return;
+        }
+
         if (it != _map.end())
         {
-            _onChanged(CollectionOp::ItemRemoved, key, it->second);
-            _listenable.invoke([&](const ListenerPtr& l) { l->OnItemRemoved(key, it->second); });
             it->second = value;
+            Notify(Changes{ Change(CollectionOp::ItemUpdated, key, value) });
         }
         else
+        {
             _map.insert({key, value});
-
-        _onChanged(CollectionOp::ItemAdded, key, value);
-        _listenable.invoke([&](const ListenerPtr& l) { l->OnItemAdded(key, value); });
+            Notify(Changes{ Change(CollectionOp::ItemAdded, key, value) });
+        }
     }
 
     virtual void Remove(const Key_& key)
@@ -114,21 +143,101 @@ public:
         if (it == _map.end())
             return false;
 
-        _onChanged(CollectionOp::ItemRemoved, key, it->second);
-        _listenable.invoke([&](const ListenerPtr& l) { l->OnItemRemoved(key, it->second); });
+        if (_updateDepth > 0)
+        {
+            RememberOriginalEntry(key, it);
+            _map.erase(it);
+            return true;
+        }
+
+        Change change(CollectionOp::ItemRemoved, key, it->second);
         _map.erase(it);
+        Notify(Changes{ change });
         return true;
     }
 
     virtual void Clear()
     {
         Lock l(*_mutex);
-        for (auto p : _map)
+        if (_updateDepth > 0)
         {
-            _onChanged(CollectionOp::ItemRemoved, p.first, p.second);
-            _listenable.invoke([&](const ListenerPtr& l) { l->OnItemRemoved(p.first, p.second); });
+            for (auto it = _map.begin(); it != _map.end(); ++it)
+                RememberOriginalEntry(it->first, it);
+            _map.clear();
+            return;
         }
+
+        Changes changes;
+        changes.reserve(_map.size());
+        for (const auto& p : _map)
+            changes.push_back(Change(CollectionOp::ItemRemoved, p.first, p.second));
         _map.clear();
+        if (!changes.empty())
+            Notify(changes);
+    }
+
+    virtual void BeginUpdate()
+    {
+        _mutex->lock();
+        ++_updateDepth;
+    }
+
+    // A key that has the same value as before the batch is not reported, so Value_ should be equality comparable
+    virtual void EndUpdate()
+    {
+        Lock l(*_mutex, std::adopt_lock);
+        if (--_updateDepth > 0)
+            return;
+
+        std::map<Key_, OriginalEntry> originalEntries;
+        originalEntries.swap(_originalEntries);
+
+        Changes changes;
+        changes.reserve(originalEntries.size());
+        for (const auto& e : originalEntries)
+        {
+            const Key_& key = e.first;
+            const OriginalEntry& original = e.second;
+            auto it = _map.find(key);
+
+            if (it == _map.end())
+            {
+                if (original.Exists)
+                    changes.push_back(Change(CollectionOp::ItemRemoved, key, original.Value));
+            }
+            else if (!original.Exists)
+                changes.push_back(Change(CollectionOp::ItemAdded, key, it->second));
+            else if (!(original.Value == it->second))
+                changes.push_back(Change(CollectionOp::ItemUpdated, key, it->second));
+        }
+
+        if (!changes.empty())
+            Notify(changes);
+    }
+
+private:
+    void RememberOriginalEntry(const Key_& key, typename std::map<Key_, Value_>::const_iterator it)
+    {
+        if (_originalEntries.find(key) != _originalEntries.end())
+            return;
+        _originalEntries.insert({key, it != _map.end() ? OriginalEntry(true, it->second) : OriginalEntry(false, Value_())});
+    }
+
+    Changes GetContents() const
+    {
+        Changes result;
+        result.reserve(_map.size());
+        for (const auto& p : _map)
+            result.push_back(Change(CollectionOp::ItemAdded, p.first, p.second));
+        return result;
+    }
+
+    void Notify(const Changes& changes)
+    {
+        for (const auto& c : changes)
+            _onChanged(c.Op, c.Key, c.Value);
+        _onChangeSet(changes);
+        _listenable.invoke([&](const ListenerPtr& l) { l->OnChanged(changes); });
     }
 };
 
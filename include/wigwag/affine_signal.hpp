@@ -0,0 +1,99 @@
+#ifndef WIGWAG_AFFINE_SIGNAL_HPP
+#define WIGWAG_AFFINE_SIGNAL_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/signal.hpp>
+#include <wigwag/task_executor.hpp>
+
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template <
+            typename Signature_,
+            typename... Policies_
+        >
+    class affine_signal;
+
+    // Delivers the emissions on the thread that executes the tasks of the worker. Emitting on that thread (as reported by
+    // task_executor::is_current) invokes the handlers synchronously, and emitting from any other one adds a single task
+    // that invokes all of them. The queued emissions of a destroyed signal are dropped
+    template <
+            typename... ArgTypes_,
+            typename... Policies_
+        >
+    class affine_signal<void(ArgTypes_...), Policies_...>
+    {
+    public:
+        using signal_type = signal<void(ArgTypes_...), Policies_...>;
+        using signature = typename signal_type::signature;
+        using handler_type = typename signal_type::handler_type;
+
+    private:
+        std::shared_ptr<task_executor>  _worker;
+        std::shared_ptr<signal_type>    _signal;
+
+    public:
+        template < typename... Args_, bool E_ = std::is_constructible<signal_type, Args_...>::value, typename = typename std::enable_if<E_>::type >
+        affine_signal(std::shared_ptr<task_executor> worker, Args_&&... args)
+            : _worker(std::move(worker)), _signal(std::make_shared<signal_type>(std::forward<Args_>(args)...))
+        { }
+
+        affine_signal(const affine_signal&) = delete;
+        affine_signal& operator = (const affine_signal&) = delete;
+
+        const std::shared_ptr<task_executor>& get_worker() const
+        { return _worker; }
+
+        auto lock_primitive() const -> decltype(std::declval<const signal_type&>().lock_primitive())
+        { return _signal->lock_primitive(); }
+
+        signal_connector<signature> connector() const
+        { return _signal->connector(); }
+
+        template < typename HandlerFunc_ >
+        token connect(HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return _signal->connect(std::move(handler), attributes); }
+
+        template < typename HandlerFunc_ >
+        token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return _signal->connect(std::move(worker), std::move(handler), attributes); }
+
+        void operator() (ArgTypes_... args) const
+        {
+            if (_worker->is_current())
+                (*_signal)(args...);
+            else
+                _worker->add_task(std::bind(&affine_signal::invoke_weak<typename std::decay<ArgTypes_>::type...>, std::weak_ptr<signal_type>(_signal), args...));
+        }
+
+    private:
+        template < typename... Args_ >
+        static void invoke_weak(const std::weak_ptr<signal_type>& weak_signal, Args_&... args)
+        {
+            std::shared_ptr<signal_type> s = weak_signal.lock();
+            if (s)
+                (*s)(args...);
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef WIGWAG_DERIVED_SIGNAL_HPP
+#define WIGWAG_DERIVED_SIGNAL_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/derived_signal_stages.hpp>
+#include <wigwag/handler_attributes.hpp>
+#include <wigwag/signal_connector.hpp>
+#include <wigwag/task_executor.hpp>
+#include <wigwag/token.hpp>
+
+#include <memory>
+#include <utility>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Signature_, typename Source_, typename Binder_ >
+    class derived_signal;
+
+    // A signal that is computed from the emissions of another one: derive(s).filter(pred).map(f).throttle(interval).
+    // The combinators do not connect anything themselves, connect() composes all of them with the handler into a single
+    // object and connects it to the source, so a derived signal costs one handler node on the source however many stages
+    // it has. Every connection gets its own state of the stages, e.g. its own throttling interval.
+    // debounce and sample deliver the emissions on the worker. Releasing the token waits for such a delivery if it has
+    // already started, so the handler should not release its own token
+    template < typename... ArgTypes_, typename Source_, typename Binder_ >
+    class derived_signal<void(ArgTypes_...), Source_, Binder_>
+    {
+        using clock = timed_task_executor::clock;
+
+        template < typename Stage_ >
+        using with_stage = derived_signal<void(ArgTypes_...), Source_, detail::stage_binder<Binder_, Stage_>>;
+
+    public:
+        using signature = void(ArgTypes_...);
+
+    private:
+        Source_     _source;
+        Binder_     _binder;
+
+    public:
+        derived_signal(Source_ source, Binder_ binder)
+            : _source(std::move(source)), _binder(std::move(binder))
+        { }
+
+        template < typename HandlerFunc_ >
+        token connect(HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return token::create<detail::derived_connection<Source_, Binder_, HandlerFunc_>>(_source, _binder, std::move(handler), attributes); }
+
+        template < typename Predicate_ >
+        with_stage<detail::filter_stage<Predicate_>> filter(Predicate_ pred) const
+        { return with_stage<detail::filter_stage<Predicate_>>(_source, detail::stage_binder<Binder_, detail::filter_stage<Predicate_>>(_binder, detail::filter_stage<Predicate_>(std::move(pred)))); }
+
+        template < typename Func_, typename Signature_ = typename detail::mapped_signature<decltype(std::declval<Func_&>()(std::declval<ArgTypes_>()...))>::type >
+        derived_signal<Signature_, Source_, detail::stage_binder<Binder_, detail::map_stage<Func_>>> map(Func_ func) const
+        { return derived_signal<Signature_, Source_, detail::stage_binder<Binder_, detail::map_stage<Func_>>>(_source, detail::stage_binder<Binder_, detail::map_stage<Func_>>(_binder, detail::map_stage<Func_>(std::move(func)))); }
+
+        // Passes the first emission and drops the following ones for the interval
+        with_stage<detail::throttle_stage> throttle(clock::duration interval) const
+        { return with_stage<detail::throttle_stage>(_source, detail::stage_binder<Binder_, detail::throttle_stage>(_binder, detail::throttle_stage(interval))); }
+
+        // Delivers the last emission of a burst on the worker once there were no emissions for the interval
+        with_stage<detail::debounce_stage<signature>> debounce(clock::duration interval, std::shared_ptr<timed_task_executor> worker) const
+        { return with_stage<detail::debounce_stage<signature>>(_source, detail::stage_binder<Binder_, detail::debounce_stage<signature>>(_binder, detail::debounce_stage<signature>(interval, std::move(worker)))); }
+
+        // Delivers the latest emission on the worker every period, if there were emissions since the previous one
+        with_stage<detail::sample_stage<signature>> sample(std::shared_ptr<timed_task_executor> worker, clock::duration period) const
+        { return with_stage<detail::sample_stage<signature>>(_source, detail::stage_binder<Binder_, detail::sample_stage<signature>>(_binder, detail::sample_stage<signature>(std::move(worker), period))); }
+    };
+
+
+    template < typename Signature_ >
+    derived_signal<Signature_, detail::connector_source<signal_connector<Signature_>>, detail::identity_binder> derive(signal_connector<Signature_> connector)
+    { return derived_signal<Signature_, detail::connector_source<signal_connector<Signature_>>, detail::identity_binder>(detail::connector_source<signal_connector<Signature_>>(std::move(connector)), detail::identity_binder()); }
+
+    template < typename Signal_ >
+    auto derive(const Signal_& s) -> decltype(derive(s.connector()))
+    { return derive(s.connector()); }
+
+
+    // Emits whenever either of the signals does. The handler is connected to both of the sources and may be called
+    // concurrently if they are emitted on different threads
+    template < typename Signature_, typename FirstSource_, typename FirstBinder_, typename SecondSource_, typename SecondBinder_ >
+    derived_signal<Signature_, detail::merged_source<derived_signal<Signature_, FirstSource_, FirstBinder_>, derived_signal<Signature_, SecondSource_, SecondBinder_>>, detail::identity_binder>
+    merge(derived_signal<Signature_, FirstSource_, FirstBinder_> first, derived_signal<Signature_, SecondSource_, SecondBinder_> second)
+    {
+        using source = detail::merged_source<derived_signal<Signature_, FirstSource_, FirstBinder_>, derived_signal<Signature_, SecondSource_, SecondBinder_>>;
+        return derived_signal<Signature_, source, detail::identity_binder>(source(std::move(first), std::move(second)), detail::identity_binder());
+    }
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
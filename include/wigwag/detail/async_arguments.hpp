@@ -0,0 +1,171 @@
+#ifndef WIGWAG_DETAIL_ASYNC_ARGUMENTS_HPP
+#define WIGWAG_DETAIL_ASYNC_ARGUMENTS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/index_sequence.hpp>
+#include <wigwag/detail/intrusive_ptr.hpp>
+#include <wigwag/detail/intrusive_ref_counter.hpp>
+#include <wigwag/policies/ref_counter/atomic.hpp>
+
+#include <tuple>
+#include <type_traits>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename... ArgTypes_ >
+    struct has_mutable_references
+    { static const bool value = false; };
+
+    template < typename Head_, typename... Tail_ >
+    struct has_mutable_references<Head_, Tail_...>
+    {
+        static const bool value =
+            (std::is_lvalue_reference<Head_>::value && !std::is_const<typename std::remove_reference<Head_>::type>::value) ||
+            has_mutable_references<Tail_...>::value;
+    };
+
+
+    template < typename Signature_ >
+    class async_arguments;
+
+    // Copies of the signal arguments that are shared by all the asynchronous handlers invoked during a single emission
+    template < typename... ArgTypes_ >
+    class async_arguments<void(ArgTypes_...)> : public intrusive_ref_counter<wigwag::ref_counter::atomic, async_arguments<void(ArgTypes_...)>>
+    {
+        using storage = std::tuple<typename std::decay<ArgTypes_>::type...>;
+
+    public:
+        // Handlers that get non-const references may modify the arguments, so every asynchronous handler needs its own copy
+        static const bool shareable = !has_mutable_references<ArgTypes_...>::value;
+
+    private:
+        storage     _args;
+
+    public:
+        template < typename... Args_ >
+        explicit async_arguments(Args_&&... args)
+            : _args(std::forward<Args_>(args)...)
+        { }
+
+        template < typename Func_ >
+        void apply(const Func_& f) const
+        { apply_impl(f, make_index_sequence<sizeof...(ArgTypes_)>()); }
+
+    private:
+        template < typename Func_, std::size_t... Indices_ >
+        void apply_impl(const Func_& f, index_sequence<Indices_...>) const
+        { f(std::get<Indices_>(_args)...); }
+    };
+
+
+    class async_emission_scope_base
+    {
+    private:
+        const void*     _tag;
+
+    public:
+        async_emission_scope_base(const void* tag)
+            : _tag(tag)
+        { }
+
+        const void* get_tag() const
+        { return _tag; }
+    };
+
+
+    template < typename Dummy_ = void >
+    struct async_emission_tls
+    { static WIGWAG_THREAD_LOCAL async_emission_scope_base* current; };
+
+    template < typename Dummy_ >
+    WIGWAG_THREAD_LOCAL async_emission_scope_base* async_emission_tls<Dummy_>::current = nullptr;
+
+
+    // Makes the handlers that are invoked outside of the signal emission (populators, withdrawers) copy the arguments
+    class async_emission_suspender
+    {
+    private:
+        async_emission_scope_base*      _prev;
+
+    public:
+        async_emission_suspender()
+            : _prev(async_emission_tls<>::current)
+        { async_emission_tls<>::current = nullptr; }
+
+        ~async_emission_suspender()
+        { async_emission_tls<>::current = _prev; }
+
+        async_emission_suspender(const async_emission_suspender&) = delete;
+        async_emission_suspender& operator = (const async_emission_suspender&) = delete;
+    };
+
+
+    template < typename Signature_, bool Enabled_ = async_arguments<Signature_>::shareable >
+    class async_emission_scope : public async_emission_scope_base
+    {
+        using arguments_ptr = intrusive_ptr<async_arguments<Signature_>>;
+
+    private:
+        async_emission_scope_base*      _prev;
+        arguments_ptr                   _arguments;
+
+    public:
+        async_emission_scope()
+            : async_emission_scope_base(tag()), _prev(async_emission_tls<>::current)
+        { async_emission_tls<>::current = this; }
+
+        ~async_emission_scope()
+        { async_emission_tls<>::current = _prev; }
+
+        async_emission_scope(const async_emission_scope&) = delete;
+        async_emission_scope& operator = (const async_emission_scope&) = delete;
+
+        template < typename... Args_ >
+        static arguments_ptr get_arguments(Args_&&... args)
+        {
+            async_emission_scope_base* current = async_emission_tls<>::current;
+            if (!current || current->get_tag() != tag())
+                return arguments_ptr(new async_arguments<Signature_>(std::forward<Args_>(args)...));
+
+            async_emission_scope* self = static_cast<async_emission_scope*>(current);
+            if (!self->_arguments)
+                self->_arguments.reset(new async_arguments<Signature_>(std::forward<Args_>(args)...));
+            return self->_arguments;
+        }
+
+    private:
+        static const void* tag()
+        {
+            static const char t = 0;
+            return &t;
+        }
+    };
+
+    template < typename Signature_ >
+    class async_emission_scope<Signature_, false>
+    {
+    public:
+        async_emission_scope() { }
+        ~async_emission_scope() { }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -11,9 +11,13 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/async_arguments.hpp>
+#include <wigwag/detail/tracing.hpp>
 #include <wigwag/task_executor.hpp>
 
+#include <functional>
 #include <memory>
+#include <type_traits>
 
 
 namespace wigwag {
@@ -28,21 +32,76 @@ namespace detail
         using life_checker = typename LifeAssurancePolicy_::life_checker;
         using execution_guard = typename LifeAssurancePolicy_::execution_guard;
 
+        using arguments = async_arguments<Signature_>;
+        using arguments_ptr = intrusive_ptr<arguments>;
+
+        class task
+        {
+        private:
+            life_checker                _life_checker;
+            std::function<Signature_>   _func;
+            arguments_ptr               _args;
+
+        public:
+            task(life_checker checker, std::function<Signature_> func, arguments_ptr args)
+                : _life_checker(std::move(checker)), _func(std::move(func)), _args(std::move(args))
+            { }
+
+            void operator() () const
+            {
+                execution_guard g(_life_checker);
+                if (g.is_alive())
+                    _args->apply(_func);
+            }
+        };
+
     private:
         std::shared_ptr<task_executor>  _worker;
         life_checker                    _life_checker;
         std::function<Signature_>       _func;
+        bool                            _inline_if_current;
 
     public:
-        async_handler(std::shared_ptr<task_executor> worker, life_checker checker, std::function<Signature_> func)
-            : _worker(std::move(worker)), _life_checker(std::move(checker)), _func(std::move(func))
+        async_handler(std::shared_ptr<task_executor> worker, life_checker checker, std::function<Signature_> func, bool inline_if_current = false)
+            : _worker(std::move(worker)), _life_checker(std::move(checker)), _func(std::move(func)), _inline_if_current(inline_if_current)
         { }
 
+        // The handler is already protected by the emission, so it is called directly if it may be executed in place
         template < typename... Args_ >
         void operator() (Args_&&... args) const
-        { _worker->add_task(std::bind(&async_handler::invoke_func<Args_&...>, _life_checker, _func, std::forward<Args_>(args)...)); }
+        {
+            if (_inline_if_current && _worker->is_current())
+                _func(std::forward<Args_>(args)...);
+            else
+                add_task(std::integral_constant<bool, arguments::shareable>(), std::forward<Args_>(args)...);
+        }
+
+        // Adds a single task that passes the whole state to the handler on the worker, so the tasks added for the
+        // subsequent emissions are executed after it. If the emissions are executed in place, so is the populator
+        void add_populating_task(std::function<void(const std::function<Signature_>&)> populator) const
+        {
+            if (_inline_if_current && _worker->is_current())
+                populator(_func);
+            else
+                _worker->add_task(make_traced_task("async populator", std::bind(&async_handler::populate, _life_checker, _func, std::move(populator))));
+        }
 
     private:
+        template < typename... Args_ >
+        void add_task(std::true_type, Args_&&... args) const
+        { _worker->add_task(make_traced_task("async handler", task(_life_checker, _func, async_emission_scope<Signature_>::get_arguments(std::forward<Args_>(args)...)))); }
+
+        template < typename... Args_ >
+        void add_task(std::false_type, Args_&&... args) const
+        { _worker->add_task(make_traced_task("async handler", std::bind(&async_handler::invoke_func<Args_&...>, _life_checker, _func, std::forward<Args_>(args)...))); }
+
+        static void populate(life_checker checker, const std::function<Signature_>& func, const std::function<void(const std::function<Signature_>&)>& populator)
+        {
+            execution_guard g(checker);
+            if (g.is_alive())
+                populator(func);
+        }
+
         template < typename... Args_ >
         static void invoke_func(life_checker checker, const std::function<Signature_>& func, Args_&&... args)
         {
@@ -0,0 +1,145 @@
+#ifndef WIGWAG_DETAIL_CONCURRENT_RING_BUFFER_HPP
+#define WIGWAG_DETAIL_CONCURRENT_RING_BUFFER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/storage_for.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A bounded queue that any thread may push to and pop from without a lock. The thread that claims an index owns its
+    // cell until it publishes the next sequence number of the cell, so the stored objects are never accessed concurrently
+    template < typename T_ >
+    class concurrent_ring_buffer
+    {
+        struct cell
+        {
+            std::atomic<std::size_t>    sequence;
+            storage_for<T_>             value;
+
+            cell() : sequence(0), value(typename storage_for<T_>::no_construct_tag()) { }
+        };
+
+        static const std::size_t cache_line_size = 64;
+
+    private:
+        std::unique_ptr<cell[]>     _cells;
+        std::size_t                 _mask;
+        char                        _head_padding[cache_line_size];
+        std::atomic<std::size_t>    _head;
+        char                        _tail_padding[cache_line_size];
+        std::atomic<std::size_t>    _tail;
+
+    public:
+        // The capacity is rounded up to a power of two
+        explicit concurrent_ring_buffer(std::size_t capacity)
+            : _cells(), _mask(round_up_to_power_of_two(capacity) - 1), _head_padding(), _head(0), _tail_padding(), _tail(0)
+        {
+            WIGWAG_ASSERT(capacity > 0, "concurrent_ring_buffer capacity should be positive!");
+            _cells.reset(new cell[_mask + 1]);
+            for (std::size_t i = 0; i <= _mask; ++i)
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        ~concurrent_ring_buffer()
+        {
+            while (try_pop([](T_&&) { }))
+                ;
+        }
+
+        concurrent_ring_buffer(const concurrent_ring_buffer&) = delete;
+        concurrent_ring_buffer& operator = (const concurrent_ring_buffer&) = delete;
+
+        std::size_t capacity() const { return _mask + 1; }
+
+        // Does not touch the arguments if the buffer is full
+        template < typename... Args_ >
+        bool try_push(Args_&&... args)
+        {
+            std::size_t pos = _tail.load(std::memory_order_relaxed);
+            cell* c;
+            for (;;)
+            {
+                c = &_cells[pos & _mask];
+                std::intptr_t dif = (std::intptr_t)c->sequence.load(std::memory_order_acquire) - (std::intptr_t)pos;
+                if (dif == 0)
+                {
+                    if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = _tail.load(std::memory_order_relaxed);
+            }
+
+            c->value.construct(std::forward<Args_>(args)...);
+            c->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Passes the oldest object to the function as an rvalue and destroys it
+        template < typename Func_ >
+        bool try_pop(const Func_& f)
+        {
+            std::size_t pos = _head.load(std::memory_order_relaxed);
+            cell* c;
+            for (;;)
+            {
+                c = &_cells[pos & _mask];
+                std::intptr_t dif = (std::intptr_t)c->sequence.load(std::memory_order_acquire) - (std::intptr_t)(pos + 1);
+                if (dif == 0)
+                {
+                    if (_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (dif < 0)
+                    return false;
+                else
+                    pos = _head.load(std::memory_order_relaxed);
+            }
+
+            auto sg = at_scope_exit([&] {
+                    c->value.destruct();
+                    c->sequence.store(pos + _mask + 1, std::memory_order_release);
+                });
+            f(std::move(c->value.ref()));
+            return true;
+        }
+
+    private:
+        static std::size_t round_up_to_power_of_two(std::size_t n)
+        {
+            std::size_t result = 1;
+            while (result < n)
+                result <<= 1;
+            return result;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
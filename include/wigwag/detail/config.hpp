@@ -111,5 +111,25 @@
 #   define WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND private
 #endif
 
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#   define WIGWAG_THREAD_LOCAL __declspec(thread)
+#   define WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS 0
+#else
+#   define WIGWAG_THREAD_LOCAL thread_local
+#   define WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS 1
+#endif
+
+#if !defined(WIGWAG_HAS_COROUTINES)
+#   if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#       if __has_include(<coroutine>)
+#           define WIGWAG_HAS_COROUTINES 1
+#       endif
+#   endif
+#endif
+
+#if !defined(WIGWAG_HAS_COROUTINES)
+#   define WIGWAG_HAS_COROUTINES 0
+#endif
+
 
 #endif
@@ -0,0 +1,96 @@
+#ifndef WIGWAG_DETAIL_DEFERRED_HANDLER_HPP
+#define WIGWAG_DETAIL_DEFERRED_HANDLER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/index_sequence.hpp>
+
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Signature_ >
+    class deferred_handler;
+
+    // Keeps copies of the arguments until activate() is called, then passes them to the handler in order and starts
+    // calling it directly. Both operator() and activate() should be called under the signal lock
+    template < typename... ArgTypes_ >
+    class deferred_handler<void(ArgTypes_...)>
+    {
+        using handler_type = std::function<void(ArgTypes_...)>;
+        using arguments = std::tuple<typename std::decay<ArgTypes_>::type...>;
+
+        struct state
+        {
+            handler_type            handler;
+            bool                    active;
+            std::vector<arguments>  pending;
+
+            state() : handler(), active(false), pending() { }
+        };
+
+    private:
+        std::shared_ptr<state>      _state;
+
+    public:
+        deferred_handler()
+            : _state(std::make_shared<state>())
+        { }
+
+        void set_handler(handler_type handler) const
+        { _state->handler = std::move(handler); }
+
+        // The handler itself, to be called directly (e.g. with the snapshot) while the others are deferred
+        const handler_type& get_handler() const
+        { return _state->handler; }
+
+        template < typename... Args_ >
+        void operator() (Args_&&... args) const
+        {
+            if (_state->active)
+                _state->handler(std::forward<Args_>(args)...);
+            else
+                _state->pending.emplace_back(std::forward<Args_>(args)...);
+        }
+
+        // The handler may emit the signal again, so the events that are queued during activation are delivered too
+        template < typename InvokeFunc_ >
+        void activate(const InvokeFunc_& invoke) const
+        {
+            for (std::size_t i = 0; i < _state->pending.size(); ++i)
+            {
+                arguments args(std::move(_state->pending[i]));
+                invoke([&] { apply(args, make_index_sequence<sizeof...(ArgTypes_)>()); });
+            }
+            _state->pending.clear();
+            _state->active = true;
+        }
+
+    private:
+        template < std::size_t... Indices_ >
+        void apply(arguments& args, index_sequence<Indices_...>) const
+        { _state->handler(std::get<Indices_>(args)...); }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
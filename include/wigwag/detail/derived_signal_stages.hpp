@@ -0,0 +1,567 @@
+#ifndef WIGWAG_DETAIL_DERIVED_SIGNAL_STAGES_HPP
+#define WIGWAG_DETAIL_DERIVED_SIGNAL_STAGES_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/index_sequence.hpp>
+#include <wigwag/detail/storage_for.hpp>
+#include <wigwag/handler_attributes.hpp>
+#include <wigwag/life_token.hpp>
+#include <wigwag/task_executor.hpp>
+#include <wigwag/token.hpp>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A binder turns the handler of a derived signal into the handler that is connected to the source. Every stage wraps
+    // the handler of the next one by value, so the whole chain is a single object that is called without indirections
+
+    struct identity_binder
+    {
+        template < typename Handler_ >
+        struct result
+        { using type = Handler_; };
+
+        template < typename Handler_ >
+        Handler_ bind(Handler_ handler, const life_token&) const
+        { return handler; }
+    };
+
+
+    template < typename Prev_, typename Stage_ >
+    class stage_binder
+    {
+    public:
+        template < typename Handler_ >
+        struct result
+        { using type = typename Prev_::template result<typename Stage_::template handler<Handler_>>::type; };
+
+    private:
+        Prev_       _prev;
+        Stage_      _stage;
+
+    public:
+        stage_binder(Prev_ prev, Stage_ stage)
+            : _prev(std::move(prev)), _stage(std::move(stage))
+        { }
+
+        template < typename Handler_ >
+        typename result<Handler_>::type bind(Handler_ handler, const life_token& life) const
+        { return _prev.bind(_stage.make(std::move(handler), life), life); }
+    };
+
+
+    template < typename Connector_ >
+    class connector_source
+    {
+    private:
+        Connector_      _connector;
+
+    public:
+        explicit connector_source(Connector_ connector)
+            : _connector(std::move(connector))
+        { }
+
+        template < typename Handler_ >
+        token connect(Handler_ handler, handler_attributes attributes) const
+        { return _connector.connect(std::move(handler), attributes); }
+    };
+
+
+    struct token_pair : public token::implementation
+    {
+        token       first;
+        token       second;
+
+        token_pair(token&& f, token&& s)
+            : first(std::move(f)), second(std::move(s))
+        { }
+
+        virtual void release_token_impl()
+        { delete this; }
+    };
+
+
+    // The handler is shared by the connections to both sources, so are the states of its stages
+    template < typename First_, typename Second_ >
+    class merged_source
+    {
+        template < typename Handler_ >
+        class shared_handler
+        {
+        private:
+            std::shared_ptr<Handler_>   _handler;
+
+        public:
+            explicit shared_handler(std::shared_ptr<Handler_> handler)
+                : _handler(std::move(handler))
+            { }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args) const
+            { (*_handler)(std::forward<Args_>(args)...); }
+        };
+
+    private:
+        First_      _first;
+        Second_     _second;
+
+    public:
+        merged_source(First_ first, Second_ second)
+            : _first(std::move(first)), _second(std::move(second))
+        { }
+
+        template < typename Handler_ >
+        token connect(Handler_ handler, handler_attributes attributes) const
+        {
+            std::shared_ptr<Handler_> h = std::make_shared<Handler_>(std::move(handler));
+            token first = _first.connect(shared_handler<Handler_>(h), attributes);
+            return token::create<token_pair>(std::move(first), _second.connect(shared_handler<Handler_>(h), attributes));
+        }
+    };
+
+
+    // Disconnects from the source first, then waits for the delayed deliveries that have already started
+    template < typename Source_, typename Binder_, typename Handler_ >
+    class derived_connection : public token::implementation
+    {
+    private:
+        life_token      _life;
+        token           _upstream;
+
+    public:
+        derived_connection(const Source_& source, const Binder_& binder, Handler_ handler, handler_attributes attributes)
+            : _life(), _upstream(source.connect(binder.bind(std::move(handler), _life), attributes))
+        { }
+
+        virtual void release_token_impl()
+        {
+            _upstream.reset();
+            _life.release();
+            delete this;
+        }
+    };
+
+
+    template < typename... ArgTypes_ >
+    class latest_emission
+    {
+    public:
+        using arguments = std::tuple<typename std::decay<ArgTypes_>::type...>;
+
+    private:
+        storage_for<arguments>      _args;
+        bool                        _empty;
+
+    public:
+        latest_emission()
+            : _args(typename storage_for<arguments>::no_construct_tag()), _empty(true)
+        { }
+
+        ~latest_emission()
+        {
+            if (!_empty)
+                _args.destruct();
+        }
+
+        latest_emission(const latest_emission&) = delete;
+        latest_emission& operator = (const latest_emission&) = delete;
+
+        bool empty() const
+        { return _empty; }
+
+        template < typename... Args_ >
+        void set(Args_&&... args)
+        {
+            if (_empty)
+            {
+                _args.construct(std::forward<Args_>(args)...);
+                _empty = false;
+            }
+            else
+                _args.ref() = arguments(std::forward<Args_>(args)...);
+        }
+
+        arguments take()
+        {
+            arguments result(std::move(_args.ref()));
+            _args.destruct();
+            _empty = true;
+            return result;
+        }
+    };
+
+
+    template < typename Handler_, typename... Args_, std::size_t... Indices_ >
+    void apply_arguments(Handler_& handler, std::tuple<Args_...>& args, index_sequence<Indices_...>)
+    { handler(std::move(std::get<Indices_>(args))...); }
+
+    template < typename Handler_, typename... Args_ >
+    void apply_arguments(Handler_& handler, std::tuple<Args_...>& args)
+    { apply_arguments(handler, args, make_index_sequence<sizeof...(Args_)>()); }
+
+
+    template < typename Predicate_ >
+    class filter_stage
+    {
+    public:
+        template < typename Next_ >
+        class handler
+        {
+        private:
+            Predicate_      _predicate;
+            Next_           _next;
+
+        public:
+            handler(Predicate_ predicate, Next_ next)
+                : _predicate(std::move(predicate)), _next(std::move(next))
+            { }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args)
+            {
+                if (_predicate(args...))
+                    _next(std::forward<Args_>(args)...);
+            }
+        };
+
+    private:
+        Predicate_      _predicate;
+
+    public:
+        explicit filter_stage(Predicate_ predicate)
+            : _predicate(std::move(predicate))
+        { }
+
+        template < typename Next_ >
+        handler<Next_> make(Next_ next, const life_token&) const
+        { return handler<Next_>(_predicate, std::move(next)); }
+    };
+
+
+    template < typename Result_ >
+    struct mapped_signature
+    { using type = void(Result_); };
+
+    template < >
+    struct mapped_signature<void>
+    { using type = void(); };
+
+
+    template < typename Func_ >
+    class map_stage
+    {
+    public:
+        template < typename Next_ >
+        class handler
+        {
+        private:
+            Func_       _func;
+            Next_       _next;
+
+        public:
+            handler(Func_ func, Next_ next)
+                : _func(std::move(func)), _next(std::move(next))
+            { }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args)
+            { invoke(std::is_void<decltype(_func(std::forward<Args_>(args)...))>(), std::forward<Args_>(args)...); }
+
+        private:
+            template < typename... Args_ >
+            void invoke(std::true_type, Args_&&... args)
+            {
+                _func(std::forward<Args_>(args)...);
+                _next();
+            }
+
+            template < typename... Args_ >
+            void invoke(std::false_type, Args_&&... args)
+            { _next(_func(std::forward<Args_>(args)...)); }
+        };
+
+    private:
+        Func_       _func;
+
+    public:
+        explicit map_stage(Func_ func)
+            : _func(std::move(func))
+        { }
+
+        template < typename Next_ >
+        handler<Next_> make(Next_ next, const life_token&) const
+        { return handler<Next_>(_func, std::move(next)); }
+    };
+
+
+    // Passes an emission if the previous one was passed at least the interval ago. Costs a clock read and an atomic
+    // load for an emission that is dropped
+    class throttle_stage
+    {
+        using clock = timed_task_executor::clock;
+
+    public:
+        template < typename Next_ >
+        class handler
+        {
+        private:
+            std::shared_ptr<std::atomic<clock::rep>>    _next_time;
+            clock::rep                                  _interval;
+            Next_                                       _next;
+
+        public:
+            handler(clock::duration interval, Next_ next)
+                : _next_time(std::make_shared<std::atomic<clock::rep>>(std::numeric_limits<clock::rep>::min())), _interval(interval.count()), _next(std::move(next))
+            { }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args)
+            {
+                clock::rep now = clock::now().time_since_epoch().count();
+                clock::rep next_time = _next_time->load(std::memory_order_relaxed);
+                if (now < next_time || !_next_time->compare_exchange_strong(next_time, now + _interval, std::memory_order_relaxed))
+                    return;
+
+                _next(std::forward<Args_>(args)...);
+            }
+        };
+
+    private:
+        clock::duration     _interval;
+
+    public:
+        explicit throttle_stage(clock::duration interval)
+            : _interval(interval)
+        { }
+
+        template < typename Next_ >
+        handler<Next_> make(Next_ next, const life_token&) const
+        { return handler<Next_>(_interval, std::move(next)); }
+    };
+
+
+    template < typename Signature_ >
+    class debounce_stage;
+
+    // An emission stores the arguments and moves the deadline. A single delayed task is pending at a time, it either
+    // waits for the moved deadline or delivers the latest arguments on the worker
+    template < typename... ArgTypes_ >
+    class debounce_stage<void(ArgTypes_...)>
+    {
+        using clock = timed_task_executor::clock;
+
+    public:
+        template < typename Next_ >
+        class handler
+        {
+            struct state
+            {
+                std::mutex                          mutex;
+                latest_emission<ArgTypes_...>       latest;
+                clock::time_point                   deadline;
+                bool                                scheduled;
+                Next_                               next;
+
+                explicit state(Next_ next) : mutex(), latest(), deadline(), scheduled(false), next(std::move(next)) { }
+            };
+            using state_ptr = std::shared_ptr<state>;
+
+            class task
+            {
+            private:
+                state_ptr               _state;
+                timed_task_executor*    _worker;
+                life_token::checker     _life_checker;
+
+            public:
+                task(state_ptr state, timed_task_executor* worker, life_token::checker checker)
+                    : _state(std::move(state)), _worker(worker), _life_checker(std::move(checker))
+                { }
+
+                void operator() () const
+                {
+                    life_token::execution_guard g(_life_checker);
+                    if (!g.is_alive())
+                        return;
+
+                    std::unique_lock<std::mutex> l(_state->mutex);
+                    clock::time_point deadline = _state->deadline;
+                    if (clock::now() < deadline)
+                    {
+                        l.unlock();
+                        _worker->add_task_at(deadline, *this);
+                        return;
+                    }
+
+                    typename latest_emission<ArgTypes_...>::arguments args(_state->latest.take());
+                    _state->scheduled = false;
+                    l.unlock();
+
+                    apply_arguments(_state->next, args);
+                }
+            };
+
+        private:
+            state_ptr                               _state;
+            std::shared_ptr<timed_task_executor>    _worker;
+            clock::duration                         _interval;
+            life_token::checker                     _life_checker;
+
+        public:
+            handler(clock::duration interval, std::shared_ptr<timed_task_executor> worker, const life_token& life, Next_ next)
+                : _state(std::make_shared<state>(std::move(next))), _worker(std::move(worker)), _interval(interval), _life_checker(life)
+            { }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args)
+            {
+                clock::time_point deadline = clock::now() + _interval;
+                {
+                    std::lock_guard<std::mutex> l(_state->mutex);
+                    _state->latest.set(std::forward<Args_>(args)...);
+                    _state->deadline = deadline;
+                    if (_state->scheduled)
+                        return;
+                    _state->scheduled = true;
+                }
+                _worker->add_task_at(deadline, task(_state, _worker.get(), _life_checker));
+            }
+        };
+
+    private:
+        clock::duration                         _interval;
+        std::shared_ptr<timed_task_executor>    _worker;
+
+    public:
+        debounce_stage(clock::duration interval, std::shared_ptr<timed_task_executor> worker)
+            : _interval(interval), _worker(std::move(worker))
+        { }
+
+        template < typename Next_ >
+        handler<Next_> make(Next_ next, const life_token& life) const
+        { return handler<Next_>(_interval, _worker, life, std::move(next)); }
+    };
+
+
+    template < typename Signature_ >
+    class sample_stage;
+
+    // An emission only stores the arguments. A periodic task on the worker delivers the latest ones if there were any
+    // emissions since the previous tick, and stops when the derived connection is released
+    template < typename... ArgTypes_ >
+    class sample_stage<void(ArgTypes_...)>
+    {
+        using clock = timed_task_executor::clock;
+
+    public:
+        template < typename Next_ >
+        class handler
+        {
+            struct state
+            {
+                std::mutex                          mutex;
+                latest_emission<ArgTypes_...>       latest;
+                Next_                               next;
+
+                explicit state(Next_ next) : mutex(), latest(), next(std::move(next)) { }
+            };
+            using state_ptr = std::shared_ptr<state>;
+
+            class task
+            {
+            private:
+                state_ptr               _state;
+                timed_task_executor*    _worker;
+                life_token::checker     _life_checker;
+                clock::duration         _period;
+                clock::time_point       _tick;
+
+            public:
+                task(state_ptr state, timed_task_executor* worker, life_token::checker checker, clock::duration period, clock::time_point tick)
+                    : _state(std::move(state)), _worker(worker), _life_checker(std::move(checker)), _period(period), _tick(tick)
+                { }
+
+                // Skips the ticks that were missed instead of catching up with them
+                void operator() () const
+                {
+                    life_token::execution_guard g(_life_checker);
+                    if (!g.is_alive())
+                        return;
+
+                    {
+                        std::unique_lock<std::mutex> l(_state->mutex);
+                        if (!_state->latest.empty())
+                        {
+                            typename latest_emission<ArgTypes_...>::arguments args(_state->latest.take());
+                            l.unlock();
+                            apply_arguments(_state->next, args);
+                        }
+                    }
+
+                    clock::time_point tick = _tick + _period;
+                    clock::time_point now = clock::now();
+                    if (tick <= now)
+                        tick = now + _period;
+                    _worker->add_task_at(tick, task(_state, _worker, _life_checker, _period, tick));
+                }
+            };
+
+        private:
+            state_ptr       _state;
+
+        public:
+            handler(clock::duration period, const std::shared_ptr<timed_task_executor>& worker, const life_token& life, Next_ next)
+                : _state(std::make_shared<state>(std::move(next)))
+            {
+                clock::time_point tick = clock::now() + period;
+                worker->add_task_at(tick, task(_state, worker.get(), life, period, tick));
+            }
+
+            template < typename... Args_ >
+            void operator() (Args_&&... args)
+            {
+                std::lock_guard<std::mutex> l(_state->mutex);
+                _state->latest.set(std::forward<Args_>(args)...);
+            }
+        };
+
+    private:
+        std::shared_ptr<timed_task_executor>    _worker;
+        clock::duration                         _period;
+
+    public:
+        sample_stage(std::shared_ptr<timed_task_executor> worker, clock::duration period)
+            : _worker(std::move(worker)), _period(period)
+        { }
+
+        template < typename Next_ >
+        handler<Next_> make(Next_ next, const life_token& life) const
+        { return handler<Next_>(_period, _worker, life, std::move(next)); }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef WIGWAG_DETAIL_EMISSION_QUEUE_HPP
+#define WIGWAG_DETAIL_EMISSION_QUEUE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
+
+#include <deque>
+#include <functional>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    class emission_queue;
+
+    template < typename Dummy_ = void >
+    struct emission_queue_tls
+    { static WIGWAG_THREAD_LOCAL emission_queue* current; };
+
+    template < typename Dummy_ >
+    WIGWAG_THREAD_LOCAL emission_queue* emission_queue_tls<Dummy_>::current = nullptr;
+
+
+    // Lives on the stack of the outermost queued emission on the thread. The queued emissions made by its handlers (and
+    // by the handlers of those, and so on) are executed one after another when it returns, so the cascade is processed
+    // breadth-first without growing the stack or nesting the signal locks
+    class emission_queue
+    {
+        using emission = std::function<void()>;
+
+    private:
+        std::deque<emission>    _emissions;
+
+    public:
+        emission_queue()
+            : _emissions()
+        { }
+
+        emission_queue(const emission_queue&) = delete;
+        emission_queue& operator = (const emission_queue&) = delete;
+
+        static emission_queue* get_current()
+        { return emission_queue_tls<>::current; }
+
+        void enqueue(emission e)
+        { _emissions.push_back(std::move(e)); }
+
+        // If an emission throws, the ones that are still queued are dropped
+        template < typename Func_ >
+        static void run(const Func_& emit)
+        {
+            emission_queue q;
+            emission_queue_tls<>::current = &q;
+            auto sg = at_scope_exit([&] { emission_queue_tls<>::current = nullptr; } );
+
+            emit();
+            while (!q._emissions.empty())
+            {
+                emission e(std::move(q._emissions.front()));
+                q._emissions.pop_front();
+                e();
+            }
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef WIGWAG_DETAIL_EMISSION_WAITER_HPP
+#define WIGWAG_DETAIL_EMISSION_WAITER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/intrusive_list.hpp>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Signature_ >
+    class emission_waiter;
+
+    // A one-shot listener that is linked into the signal instead of a handler node, so waiting for an emission does not
+    // allocate anything. The signal unlinks the waiter before notifying it, under the lock
+    template < typename... ArgTypes_ >
+    class emission_waiter<void(ArgTypes_...)> : private intrusive_list_node
+    {
+        friend class intrusive_list<emission_waiter>;
+
+    public:
+        virtual ~emission_waiter() { }
+
+        virtual void notify(ArgTypes_... args) = 0;
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef WIGWAG_DETAIL_HAZARD_POINTERS_HPP
+#define WIGWAG_DETAIL_HAZARD_POINTERS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Hazard pointers: before accessing an object a thread publishes a pointer to it in one of its slots, and the code
+    // that is going to destroy the object (or has to make sure nobody executes it anymore) checks the slots of all the
+    // threads. The slots of a thread are used as a stack, so the guards may be nested
+    class hazard_pointer_record
+    {
+        friend class hazard_pointers;
+        friend class hazard_pointer;
+
+        static const std::size_t slots_per_block = 8;
+
+        struct slots_block
+        {
+            std::atomic<const void*>    slots[slots_per_block];
+            std::atomic<slots_block*>   next;
+
+            slots_block()
+                : next(nullptr)
+            {
+                for (auto& s : slots)
+                    s.store(nullptr, std::memory_order_relaxed);
+            }
+
+            ~slots_block()
+            { delete next.load(std::memory_order_relaxed); }
+
+            slots_block(const slots_block&) = delete;
+            slots_block& operator = (const slots_block&) = delete;
+        };
+
+        struct retired_object
+        {
+            void*   ptr;
+            void    (*deleter)(void*);
+        };
+
+    private:
+        slots_block                     _first_block;
+        hazard_pointer_record*          _next;
+        std::atomic<bool>               _in_use;
+
+        // Accessed by the owner thread only. The retired objects that are still protected when the thread exits are
+        // reclaimed by the next thread that takes the record
+        std::size_t                     _depth;
+        std::vector<retired_object>     _retired;
+
+    public:
+        hazard_pointer_record()
+            : _first_block(), _next(nullptr), _in_use(true), _depth(0), _retired()
+        { }
+
+        hazard_pointer_record(const hazard_pointer_record&) = delete;
+        hazard_pointer_record& operator = (const hazard_pointer_record&) = delete;
+
+    private:
+        std::atomic<const void*>& push_slot()
+        {
+            std::size_t i = _depth++;
+            slots_block* b = &_first_block;
+            for (; i >= slots_per_block; i -= slots_per_block)
+            {
+                slots_block* next = b->next.load(std::memory_order_relaxed);
+                if (!next)
+                {
+                    next = new slots_block;
+                    b->next.store(next, std::memory_order_release);
+                }
+                b = next;
+            }
+            return b->slots[i];
+        }
+
+        void pop_slot(std::atomic<const void*>& slot)
+        {
+            slot.store(nullptr, std::memory_order_release);
+            --_depth;
+        }
+
+        template < typename Func_ >
+        void for_each_protected(const Func_& f) const
+        {
+            for (const slots_block* b = &_first_block; b; b = b->next.load(std::memory_order_acquire))
+                for (const auto& s : b->slots)
+                {
+                    const void* p = s.load(std::memory_order_acquire);
+                    if (p)
+                        f(p);
+                }
+        }
+    };
+
+
+    template < typename Dummy_ = void >
+    struct hazard_pointers_globals
+    {
+        static std::atomic<hazard_pointer_record*>          records;
+        static WIGWAG_THREAD_LOCAL hazard_pointer_record*   current;
+    };
+
+    template < typename Dummy_ >
+    std::atomic<hazard_pointer_record*> hazard_pointers_globals<Dummy_>::records(nullptr);
+
+    template < typename Dummy_ >
+    WIGWAG_THREAD_LOCAL hazard_pointer_record* hazard_pointers_globals<Dummy_>::current = nullptr;
+
+#if WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS
+    // Gives the record back when the thread exits
+    struct hazard_pointer_record_owner
+    {
+        hazard_pointer_record*  record = nullptr;
+
+        ~hazard_pointer_record_owner();
+    };
+
+    template < typename Dummy_ = void >
+    struct hazard_pointers_owner_tls
+    { static thread_local hazard_pointer_record_owner owner; };
+
+    template < typename Dummy_ >
+    thread_local hazard_pointer_record_owner hazard_pointers_owner_tls<Dummy_>::owner;
+#endif
+
+
+    // The records of the threads are never freed, but are reused by the new threads
+    class hazard_pointers
+    {
+        friend class hazard_pointer;
+        friend struct hazard_pointer_record_owner;
+
+        static const std::size_t scan_threshold = 64;
+
+    public:
+        // Returns true if any thread but the current one has published p
+        static bool is_protected_by_others(const void* p)
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            const hazard_pointer_record* self = hazard_pointers_globals<>::current;
+            bool result = false;
+            for (const hazard_pointer_record* r = hazard_pointers_globals<>::records.load(std::memory_order_acquire); r && !result; r = r->_next)
+                if (r != self)
+                    r->for_each_protected([&](const void* hp) { result = result || hp == p; });
+            return result;
+        }
+
+        // Used to make sure no other thread is executing the object. The current thread is skipped, so an object may
+        // wait for itself from inside its own execution
+        static void wait_unprotected(const void* p)
+        {
+            for (int i = 0; is_protected_by_others(p); ++i)
+            {
+                if (i < 64)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(i < 256 ? 10 : 1000));
+            }
+        }
+
+        // The object is destroyed once none of the threads protect it
+        template < typename T_ >
+        static void retire(T_* p)
+        { retire(p, [](void* obj) { delete static_cast<T_*>(obj); }); }
+
+        static void retire(void* p, void (*deleter)(void*))
+        {
+            hazard_pointer_record& r = current_record();
+            r._retired.push_back(hazard_pointer_record::retired_object{ p, deleter });
+            if (r._retired.size() >= scan_threshold)
+                reclaim(r);
+        }
+
+        // Destroys the objects retired by the current thread that are not protected anymore
+        static void reclaim()
+        { reclaim(current_record()); }
+
+    private:
+        static hazard_pointer_record& current_record()
+        {
+            hazard_pointer_record* r = hazard_pointers_globals<>::current;
+            return r ? *r : acquire_record();
+        }
+
+        static hazard_pointer_record& acquire_record()
+        {
+            hazard_pointer_record* result = nullptr;
+
+            auto& records = hazard_pointers_globals<>::records;
+            for (hazard_pointer_record* r = records.load(std::memory_order_acquire); r && !result; r = r->_next)
+            {
+                bool in_use = false;
+                if (!r->_in_use.load(std::memory_order_relaxed) && r->_in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire))
+                    result = r;
+            }
+
+            if (!result)
+            {
+                result = new hazard_pointer_record;
+                hazard_pointer_record* head = records.load(std::memory_order_relaxed);
+                do
+                    result->_next = head;
+                while (!records.compare_exchange_weak(head, result, std::memory_order_release, std::memory_order_relaxed));
+            }
+
+            hazard_pointers_globals<>::current = result;
+#if WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS
+            hazard_pointers_owner_tls<>::owner.record = result;
+#endif
+            return *result;
+        }
+
+        static void release_record(hazard_pointer_record& r)
+        {
+            WIGWAG_ASSERT(r._depth == 0, "A hazard pointer outlives its thread!");
+            reclaim(r);
+            hazard_pointers_globals<>::current = nullptr;
+            r._in_use.store(false, std::memory_order_release);
+        }
+
+        static void reclaim(hazard_pointer_record& self)
+        {
+            if (self._retired.empty())
+                return;
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            std::vector<const void*> protected_ptrs;
+            for (const hazard_pointer_record* r = hazard_pointers_globals<>::records.load(std::memory_order_acquire); r; r = r->_next)
+                r->for_each_protected([&](const void* p) { protected_ptrs.push_back(p); });
+            std::sort(protected_ptrs.begin(), protected_ptrs.end());
+
+            std::vector<hazard_pointer_record::retired_object> retired;
+            retired.swap(self._retired);
+            for (const auto& o : retired)
+            {
+                if (std::binary_search(protected_ptrs.begin(), protected_ptrs.end(), static_cast<const void*>(o.ptr)))
+                    self._retired.push_back(o);
+                else
+                    o.deleter(o.ptr);
+            }
+        }
+    };
+
+#if WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS
+    inline hazard_pointer_record_owner::~hazard_pointer_record_owner()
+    {
+        if (record)
+            hazard_pointers::release_record(*record);
+    }
+#endif
+
+
+    // Publishes the pointer until destroyed or reset. The guards of a thread should be released in the reverse order
+    class hazard_pointer
+    {
+    private:
+        hazard_pointer_record*      _record;
+        std::atomic<const void*>*   _slot;
+
+    public:
+        explicit hazard_pointer(const void* p)
+            : _record(&hazard_pointers::current_record()), _slot(&_record->push_slot())
+        { _slot->store(p, std::memory_order_seq_cst); }
+
+        ~hazard_pointer()
+        { reset(); }
+
+        hazard_pointer(const hazard_pointer&) = delete;
+        hazard_pointer& operator = (const hazard_pointer&) = delete;
+
+        void reset()
+        {
+            if (!_slot)
+                return;
+            _record->pop_slot(*_slot);
+            _slot = nullptr;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef WIGWAG_DETAIL_HISTOGRAM_HPP
+#define WIGWAG_DETAIL_HISTOGRAM_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/histogram_snapshot.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Lock-free: the counters are updated with relaxed atomics, so a snapshot taken during recording may be slightly inconsistent
+    class histogram
+    {
+    private:
+        std::atomic<uint64_t>   _buckets[histogram_snapshot::buckets_count];
+        std::atomic<uint64_t>   _sum;
+        std::atomic<uint64_t>   _max;
+
+    public:
+        histogram()
+            : _sum(0), _max(0)
+        {
+            for (auto& b : _buckets)
+                b.store(0, std::memory_order_relaxed);
+        }
+
+        histogram(const histogram&) = delete;
+        histogram& operator = (const histogram&) = delete;
+
+        void record(uint64_t value)
+        {
+            _buckets[histogram_snapshot::bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+            _sum.fetch_add(value, std::memory_order_relaxed);
+
+            uint64_t max = _max.load(std::memory_order_relaxed);
+            while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+                ;
+        }
+
+        histogram_snapshot get_snapshot() const
+        {
+            std::vector<uint64_t> buckets(histogram_snapshot::buckets_count);
+            for (std::size_t i = 0; i < buckets.size(); ++i)
+                buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+            return histogram_snapshot(std::move(buckets), _sum.load(std::memory_order_relaxed), _max.load(std::memory_order_relaxed));
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <wigwag/detail/iterator_base.hpp>
 
+#include <atomic>
 #include <iterator>
 #include <type_traits>
 
@@ -26,12 +27,18 @@ namespace detail
     template < typename T_ >
     class intrusive_list;
 
+    template < typename T_ >
+    class intrusive_append_stack;
+
 
     class intrusive_list_node
     {
         template < typename T_ >
         friend class intrusive_list;
 
+        template < typename T_ >
+        friend class intrusive_append_stack;
+
     private:
         intrusive_list_node*    _prev;
         intrusive_list_node*    _next;
@@ -117,6 +124,73 @@ namespace detail
 
         void push_back(T_& node) { node.insert_before(_root); }
         void erase(T_& node) { node.unlink(); }
+
+        // Appends all the nodes to the other list, leaving this one empty
+        void move_to(intrusive_list& other)
+        {
+            if (empty())
+                return;
+
+            intrusive_list_node* first = _root._next;
+            intrusive_list_node* last = _root._prev;
+
+            first->_prev = other._root._prev;
+            first->_prev->_next = first;
+            last->_next = &other._root;
+            other._root._prev = last;
+
+            _root._prev = _root._next = &_root;
+        }
+    };
+
+
+    // Nodes that are not in a list yet may be pushed here concurrently without a lock. They are linked through _prev
+    // until the owner of the list moves them there
+    template < typename T_ >
+    class intrusive_append_stack
+    {
+        static_assert(std::is_base_of<intrusive_list_node, T_>::value, "intrusive_list_node should be a base of T_");
+
+    private:
+        std::atomic<intrusive_list_node*>   _top;
+
+    public:
+        intrusive_append_stack() : _top(nullptr) { }
+
+        intrusive_append_stack(const intrusive_append_stack&) = delete;
+        intrusive_append_stack& operator = (const intrusive_append_stack&) = delete;
+
+        bool empty() const { return _top.load(std::memory_order_relaxed) == nullptr; }
+
+        void push(T_& node)
+        {
+            intrusive_list_node* n = &node;
+            intrusive_list_node* top = _top.load(std::memory_order_relaxed);
+            do
+                n->_prev = top;
+            while (!_top.compare_exchange_weak(top, n, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        // Appends the nodes to the list in the order they were pushed
+        void move_to(intrusive_list<T_>& list)
+        {
+            if (empty())
+                return;
+
+            intrusive_list_node* first = nullptr;
+            for (intrusive_list_node* n = _top.exchange(nullptr, std::memory_order_acquire), *prev; n; n = prev)
+            {
+                prev = n->_prev;
+                n->_next = first;
+                first = n;
+            }
+
+            for (intrusive_list_node* n = first, *next; n; n = next)
+            {
+                next = n->_next;
+                list.push_back(static_cast<T_&>(*n));
+            }
+        }
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
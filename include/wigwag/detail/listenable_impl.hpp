@@ -11,14 +11,22 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/async_arguments.hpp>
 #include <wigwag/detail/at_scope_exit.hpp>
 #include <wigwag/detail/config.hpp>
 #include <wigwag/detail/enabler.hpp>
 #include <wigwag/detail/intrusive_list.hpp>
 #include <wigwag/detail/intrusive_ptr.hpp>
 #include <wigwag/detail/intrusive_ref_counter.hpp>
+#include <wigwag/detail/probes.hpp>
 #include <wigwag/detail/storage_for.hpp>
+#include <wigwag/detail/tracing.hpp>
 #include <wigwag/handler_attributes.hpp>
+#include <wigwag/policies/life_assurance/none.hpp>
+#include <wigwag/policies/life_assurance/single_threaded.hpp>
+#include <wigwag/policies/profiling/none.hpp>
+#include <wigwag/policies/ref_counter/atomic.hpp>
+#include <wigwag/policies/threading/none.hpp>
 #include <wigwag/token.hpp>
 
 
@@ -40,23 +48,61 @@ namespace detail
     { static const bool value = std::is_constructible<ShouldBeConstructible_, Arg_>::value; };
 
 
+    // Handler nodes may be moved to another listenable_impl only if nothing can access them concurrently and the life checkers do not keep pointers to the shared data
+    template < typename ThreadingPolicy_, typename LifeAssurancePolicy_ >
+    struct is_relocatable
+    {
+        static const bool value =
+            std::is_same<ThreadingPolicy_, wigwag::threading::none>::value &&
+            (std::is_same<LifeAssurancePolicy_, wigwag::life_assurance::none>::value || std::is_same<LifeAssurancePolicy_, wigwag::life_assurance::single_threaded>::value);
+    };
+
+
+    // Counts the emissions that are running on a relocatable implementation, so that an embedded one is not destroyed under them
+    template < bool Enabled_ >
+    class emission_depth_counter
+    {
+    private:
+        int     _emission_depth;
+
+    public:
+        emission_depth_counter() : _emission_depth(0) { }
+
+        void emission_started() { ++_emission_depth; }
+        void emission_finished() { --_emission_depth; }
+        bool is_emitting() const { return _emission_depth != 0; }
+    };
+
+    template < >
+    class emission_depth_counter<false>
+    {
+    public:
+        void emission_started() { }
+        void emission_finished() { }
+        bool is_emitting() const { return false; }
+    };
+
+
     template <
             typename HandlerType_,
             typename ExceptionHandlingPolicy_,
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename Profiler_ = wigwag::profiling::none::profiler<void>
         >
     class listenable_impl
-        :   private intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>,
+        :   private intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, Profiler_>>,
             protected LifeAssurancePolicy_::shared_data,
             protected ExceptionHandlingPolicy_,
             protected ThreadingPolicy_::lock_primitive,
-            protected StatePopulatingPolicy_::template handler_processor<HandlerType_>
+            protected StatePopulatingPolicy_::template handler_processor<HandlerType_>,
+            protected Profiler_,
+            protected emission_depth_counter<is_relocatable<ThreadingPolicy_, LifeAssurancePolicy_>::value>
     {
-        friend class intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>;
-        using ref_counter_base = intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>>;
+        friend class intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, Profiler_>>;
+        using ref_counter_base = intrusive_ref_counter<RefCounterPolicy_, listenable_impl<HandlerType_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, Profiler_>>;
 
     public:
         using handler_type = HandlerType_;
@@ -64,41 +110,69 @@ namespace detail
         using exception_handler = ExceptionHandlingPolicy_;
         using lock_primitive = typename ThreadingPolicy_::lock_primitive;
         using handler_processor = typename StatePopulatingPolicy_::template handler_processor<handler_type>;
+        using profiler = Profiler_;
 
         using life_assurance = typename LifeAssurancePolicy_::life_assurance;
         using life_checker = typename LifeAssurancePolicy_::life_checker;
         using execution_guard = typename LifeAssurancePolicy_::execution_guard;
 
+        static const bool relocatable = is_relocatable<ThreadingPolicy_, LifeAssurancePolicy_>::value;
+
+        // Without a populator, nothing has to be done under the lock when a handler is connected, so new nodes are pushed to
+        // a lock-free stack that is moved to the handlers list by the next call that takes the lock
+        static const bool lock_free_appends =
+            !std::is_same<ThreadingPolicy_, wigwag::threading::none>::value &&
+            std::is_same<RefCounterPolicy_, wigwag::ref_counter::atomic>::value;
+
+        struct relocation_tag { };
+
     protected:
-        class handler_node : public token::implementation, private life_assurance, private detail::intrusive_list_node
+        class handler_node : public token::implementation, private life_assurance, private detail::intrusive_list_node, private profiler::handler_data
         {
             friend class detail::intrusive_list<handler_node>;
+            friend class detail::intrusive_append_stack<handler_node>;
 
         private:
             intrusive_ptr<listenable_impl>  _listenable_impl;
             storage_for<handler_type>       _handler;
 
+        protected:
+            // The node may be accessed by other threads once it is added, so the derived classes add it after their own initialization
+            struct add_later_tag { };
+
+            template < typename MakeHandlerFunc_ >
+            handler_node(add_later_tag, intrusive_ptr<listenable_impl> impl, const MakeHandlerFunc_& mhf)
+                : _listenable_impl(std::move(impl)), _handler(mhf(life_checker(*_listenable_impl, *this)))
+            { }
+
+            handler_node(add_later_tag, intrusive_ptr<listenable_impl> impl, handler_type handler)
+                : _listenable_impl(std::move(impl)), _handler(std::move(handler))
+            { }
+
         public:
             template < typename MakeHandlerFunc_ >
             handler_node(intrusive_ptr<listenable_impl> impl, const MakeHandlerFunc_& mhf)
-                : _listenable_impl(std::move(impl)), _handler(mhf(life_checker(*_listenable_impl, *this)))
-            { _listenable_impl->get_handlers_container().push_back(*this); }
+                : handler_node(add_later_tag(), std::move(impl), mhf)
+            { add_to_listenable(); }
 
             handler_node(intrusive_ptr<listenable_impl> impl, handler_type handler)
-                : _listenable_impl(std::move(impl)), _handler(std::move(handler))
-            { _listenable_impl->get_handlers_container().push_back(*this); }
+                : handler_node(add_later_tag(), std::move(impl), std::move(handler))
+            { add_to_listenable(); }
 
             virtual ~handler_node()
             { }
 
             virtual void release_token_impl()
             {
+                WIGWAG_PROBE2(listenable__disconnect, _listenable_impl.get(), this);
+
                 life_assurance::release_life_assurance(*_listenable_impl);
 
                 if (!suppress_populator() && _listenable_impl->get_handler_processor().has_withdraw_state())
                 {
                     _listenable_impl->get_lock_primitive().lock_nonrecursive();
                     auto sg = detail::at_scope_exit([&] { _listenable_impl->get_lock_primitive().unlock_nonrecursive(); } );
+                    async_emission_suspender s;
                     _listenable_impl->get_handler_processor().withdraw_state(_handler.ref());
                 }
 
@@ -109,7 +183,9 @@ namespace detail
                     {
                         _listenable_impl->get_lock_primitive().lock_nonrecursive();
                         auto sg = detail::at_scope_exit([&] { _listenable_impl->get_lock_primitive().unlock_nonrecursive(); } );
+                        _listenable_impl->add_pending_nodes();
                         _listenable_impl->get_handlers_container().erase(*this);
+                        _listenable_impl->get_profiler().handler_removed(get_profile_data());
                     }
                     delete this;
                 }
@@ -123,14 +199,28 @@ namespace detail
                 if (life_assurance::release_node())
                 {
                     _listenable_impl->get_handlers_container().erase(*this);
+                    _listenable_impl->get_profiler().handler_removed(get_profile_data());
                     delete this;
                 }
             }
 
+            void rebind(intrusive_ptr<listenable_impl> impl)
+            { _listenable_impl = std::move(impl); }
+
             handler_type& get_handler() { return _handler.ref(); }
             const life_assurance& get_life_assurance() const { return *this; }
+            typename profiler::handler_data& get_profile_data() { return *this; }
 
         protected:
+            void add_to_listenable()
+            {
+                _listenable_impl->get_profiler().handler_added(get_profile_data());
+                if (_listenable_impl->appends_lock_free())
+                    _listenable_impl->_pending_handlers.push(*this);
+                else
+                    _listenable_impl->get_handlers_container().push_back(*this);
+            }
+
             virtual bool suppress_populator()
             { return false; }
         };
@@ -143,8 +233,8 @@ namespace detail
         public:
             template < typename... Args_ >
             handler_node_with_attributes(handler_attributes attributes, Args_&&... args)
-                : handler_node(std::forward<Args_>(args)...), _attributes(attributes)
-            { }
+                : handler_node(typename handler_node::add_later_tag(), std::forward<Args_>(args)...), _attributes(attributes)
+            { this->add_to_listenable(); }
 
         protected:
             virtual bool suppress_populator()
@@ -153,7 +243,8 @@ namespace detail
 
         using handlers_container = detail::intrusive_list<handler_node>;
 
-        handlers_container                  _handlers;
+        handlers_container                              _handlers;
+        detail::intrusive_append_stack<handler_node>    _pending_handlers;
 
     public:
         template <
@@ -196,12 +287,17 @@ namespace detail
             : exception_handler(std::move(eh)), lock_primitive(std::move(lp)), handler_processor(std::move(hp))
         { }
 
+        listenable_impl(relocation_tag, const listenable_impl& other)
+            : exception_handler(other.get_exception_handler()), handler_processor(other.get_handler_processor())
+        { }
+
         listenable_impl(const listenable_impl&) = delete;
         listenable_impl& operator = (const listenable_impl&) = delete;
 
 
         void finalize_nodes()
         {
+            add_pending_nodes();
             for (auto it = _handlers.begin(); it != _handlers.end();)
                 (it++)->finalize_node();
         }
@@ -209,8 +305,23 @@ namespace detail
         void add_ref() { ref_counter_base::add_ref(); }
         void release() { ref_counter_base::release(); }
 
+        bool has_nodes() const
+        { return !_handlers.empty() || !_pending_handlers.empty(); }
+
+        using emission_depth_counter<relocatable>::is_emitting;
+
+        listenable_impl* relocate()
+        {
+            listenable_impl* result = new listenable_impl(relocation_tag(), *this);
+            move_nodes_to(*result);
+            return result;
+        }
+
         token connect(handler_type handler, handler_attributes attributes)
         {
+            if (appends_lock_free())
+                return create_node(attributes, std::move(handler));
+
             get_lock_primitive().lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_nonrecursive(); } );
 
@@ -226,6 +337,14 @@ namespace detail
             get_lock_primitive().lock_recursive();
             auto sg = detail::at_scope_exit([&] { get_lock_primitive().unlock_recursive(); } );
 
+            WIGWAG_PROBE1(signal__emit__start, this);
+            auto probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE1(signal__emit__end, this); } );
+            WIGWAG_TRACE_SCOPE("signal emit", this);
+
+            this->emission_started();
+            auto depth_sg = detail::at_scope_exit([&] { this->emission_finished(); } );
+
+            add_pending_nodes();
             if (this->_handlers.empty())
                 return;
             auto it = this->_handlers.begin(), e = this->_handlers.pre_end();
@@ -243,7 +362,12 @@ namespace detail
 
                 execution_guard g(get_life_assurance_shared_data(), it->get_life_assurance());
                 if (g.is_alive())
+                {
+                    WIGWAG_PROBE2(handler__start, this, &*it);
+                    auto handler_probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE2(handler__end, this, &*it); } );
+                    WIGWAG_TRACE_SCOPE("handler", &*it);
                     get_exception_handler().handle_exceptions(invoke_listener_func, it->get_handler());
+                }
                 ++it;
             }
         }
@@ -251,9 +375,29 @@ namespace detail
         const lock_primitive& get_lock_primitive() const { return *this; }
 
     protected:
+        void move_nodes_to(listenable_impl& other)
+        {
+            static_assert(relocatable, "Handler nodes of this listenable_impl can not be relocated!");
+
+            add_pending_nodes();
+
+            for (auto it = _handlers.begin(); it != _handlers.end();)
+            {
+                handler_node& n = *it++;
+                _handlers.erase(n);
+                other._handlers.push_back(n);
+
+                other.add_ref();
+                n.rebind(intrusive_ptr<listenable_impl>(&other));
+                other.get_profiler().handler_moved(n.get_profile_data(), get_profiler());
+            }
+        }
+
         template < typename... Args_>
         token create_node(handler_attributes attributes, Args_&&... args)
         {
+            WIGWAG_PROBE2(listenable__connect, this, static_cast<int>(attributes));
+
             add_ref();
             intrusive_ptr<listenable_impl> self(this);
 
@@ -263,8 +407,21 @@ namespace detail
                 return token::create<handler_node_with_attributes>(attributes, self, std::forward<Args_>(args)...);
         }
 
+        bool appends_lock_free() const
+        { return lock_free_appends && !get_handler_processor().has_populate_state(); }
+
+        // Should be called under the lock before accessing the handlers list
+        void add_pending_nodes()
+        {
+            if (lock_free_appends)
+                _pending_handlers.move_to(_handlers);
+        }
+
         const typename LifeAssurancePolicy_::shared_data& get_life_assurance_shared_data() const { return *this; }
 
+        // The handler nodes notify the profiler without a virtual call, so that profiling::none costs nothing
+        profiler& get_profiler() { return *this; }
+
         handlers_container& get_handlers_container() { return _handlers; }
         const handlers_container& get_handlers_container() const { return _handlers; }
 
@@ -0,0 +1,163 @@
+#ifndef WIGWAG_DETAIL_OBSERVABLE_COLLECTION_HPP
+#define WIGWAG_DETAIL_OBSERVABLE_COLLECTION_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/observable/change_set.hpp>
+#include <wigwag/observable/update_scope.hpp>
+#include <wigwag/signal.hpp>
+
+#include <iterator>
+#include <mutex>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // The common part of the observable collections: the current snapshot and the signal that reports the change sets. New
+    // handlers are populated with a reset to the current snapshot outside the lock, taking the snapshot is O(1).
+    // Derived_::compact_changes merges the changes of a batch into the ones reported at its end
+    template < typename Derived_, typename Snapshot_, typename Change_, typename... Policies_ >
+    class observable_collection
+    {
+    public:
+        using snapshot_type = Snapshot_;
+        using change_type = Change_;
+        using change_set_type = observable::change_set<Snapshot_, Change_>;
+        using handler_type = std::function<void(const change_set_type&)>;
+
+    private:
+        using signal_type = signal<void(const change_set_type&), wigwag::threading::own_recursive_mutex, wigwag::state_populating::snapshot_populator, Policies_...>;
+
+    protected:
+        using lock_guard = std::lock_guard<std::recursive_mutex>;
+
+    private:
+        Snapshot_               _state;
+        signal_type             _on_changed;
+        std::size_t             _batch_depth;
+        Snapshot_               _batch_previous;
+        std::vector<Change_>    _batch_changes;
+
+    protected:
+        explicit observable_collection(Snapshot_ state = Snapshot_())
+            : _state(std::move(state)),
+              _on_changed([this] { return make_populator(_state); }),
+              _batch_depth(0), _batch_previous(), _batch_changes()
+        { }
+
+        ~observable_collection() { }
+
+    public:
+        observable_collection(const observable_collection&) = delete;
+        observable_collection& operator = (const observable_collection&) = delete;
+
+        std::recursive_mutex& sync_root() const { return _on_changed.lock_primitive(); }
+
+        signal_connector<void(const change_set_type&)> on_changed() const
+        { return _on_changed.connector(); }
+
+        template < typename HandlerFunc_ >
+        token connect(HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return _on_changed.connect(std::move(handler), attributes); }
+
+        template < typename HandlerFunc_ >
+        token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
+        { return _on_changed.connect(std::move(worker), std::move(handler), attributes); }
+
+        Snapshot_ get_snapshot() const
+        {
+            lock_guard l(sync_root());
+            return _state;
+        }
+
+        std::size_t size() const
+        {
+            lock_guard l(sync_root());
+            return _state.size();
+        }
+
+        bool empty() const
+        {
+            lock_guard l(sync_root());
+            return _state.empty();
+        }
+
+        // The modifications made until the matching end_update() are reported as one change set, with the changes of
+        // the same items merged. The calling thread keeps the collection locked for the whole batch. Batches may be nested
+        void begin_update()
+        {
+            sync_root().lock();
+            if (_batch_depth++ == 0)
+                _batch_previous = _state;
+        }
+
+        void end_update()
+        {
+            auto sg = at_scope_exit([&] { sync_root().unlock(); });
+
+            WIGWAG_ASSERT(_batch_depth > 0, "end_update() without begin_update()!");
+            if (--_batch_depth != 0)
+                return;
+
+            Snapshot_ previous(std::move(_batch_previous));
+            std::vector<Change_> changes(std::move(_batch_changes));
+            _batch_previous = Snapshot_();
+            _batch_changes.clear();
+
+            changes = Derived_::compact_changes(previous, _state, std::move(changes));
+            if (!changes.empty())
+                _on_changed(change_set_type(std::move(previous), _state, std::move(changes)));
+        }
+
+    protected:
+        // Should be called under the lock
+        const Snapshot_& get_state() const { return _state; }
+
+        static std::function<void(const handler_type&)> make_populator(Snapshot_ state)
+        { return [state](const handler_type& h) { h(change_set_type(Snapshot_(), state, std::vector<Change_>(1, Derived_::make_reset_change(Snapshot_(), state)))); }; }
+
+        // Should be called under the lock
+        void commit(Snapshot_ state, std::vector<Change_> changes)
+        {
+            if (changes.empty())
+                return;
+
+            if (_batch_depth != 0)
+            {
+                _state = std::move(state);
+                std::move(changes.begin(), changes.end(), std::back_inserter(_batch_changes));
+                return;
+            }
+
+            Snapshot_ previous(std::move(_state));
+            _state = std::move(state);
+            _on_changed(change_set_type(std::move(previous), _state, std::move(changes)));
+        }
+
+        void reset(Snapshot_ state)
+        {
+            lock_guard l(sync_root());
+            std::vector<Change_> changes(1, Derived_::make_reset_change(_state, state));
+            commit(std::move(state), std::move(changes));
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,133 @@
+#ifndef WIGWAG_DETAIL_OBSERVABLE_MAP_BASE_HPP
+#define WIGWAG_DETAIL_OBSERVABLE_MAP_BASE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/observable_collection.hpp>
+#include <wigwag/observable/map_change.hpp>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Snapshot_, typename Change_, typename... Policies_ >
+    class observable_map_base : public observable_collection<observable_map_base<Snapshot_, Change_, Policies_...>, Snapshot_, Change_, Policies_...>
+    {
+        using base = observable_collection<observable_map_base<Snapshot_, Change_, Policies_...>, Snapshot_, Change_, Policies_...>;
+        using lock_guard = typename base::lock_guard;
+
+        friend base;
+
+    public:
+        using key_type = typename Snapshot_::key_type;
+        using mapped_type = typename Snapshot_::mapped_type;
+        using value_type = typename Snapshot_::value_type;
+
+    protected:
+        observable_map_base() { }
+
+    public:
+        bool contains(const key_type& key) const
+        {
+            lock_guard l(this->sync_root());
+            return this->get_state().contains(key);
+        }
+
+        mapped_type at(const key_type& key) const
+        {
+            lock_guard l(this->sync_root());
+            return this->get_state().at(key);
+        }
+
+        void set(const key_type& key, mapped_type value)
+        {
+            lock_guard l(this->sync_root());
+            std::vector<Change_> changes;
+            Snapshot_ state = do_set(this->get_state(), key, std::move(value), changes);
+            this->commit(std::move(state), std::move(changes));
+        }
+
+        // All the entries are reported in one change set, with one change per key
+        template < typename It_ >
+        void insert(It_ first, It_ last)
+        {
+            lock_guard l(this->sync_root());
+            std::vector<Change_> changes;
+            Snapshot_ state = this->get_state();
+            for (; first != last; ++first)
+                state = do_set(state, first->first, first->second, changes);
+            changes = compact_changes(this->get_state(), state, std::move(changes));
+            this->commit(std::move(state), std::move(changes));
+        }
+
+        bool erase(const key_type& key)
+        {
+            lock_guard l(this->sync_root());
+            const Snapshot_& state = this->get_state();
+            typename Change_::entry_ptr old_entry = state.find_entry(key);
+            if (!old_entry)
+                return false;
+            this->commit(state.erased(key), std::vector<Change_>(1, Change_(observable::change_kind::removed, std::move(old_entry), typename Change_::entry_ptr())));
+            return true;
+        }
+
+        void clear()
+        { this->reset(Snapshot_()); }
+
+    private:
+        static Snapshot_ do_set(const Snapshot_& state, const key_type& key, mapped_type value, std::vector<Change_>& changes)
+        {
+            typename Change_::entry_ptr old_entry, new_entry;
+            Snapshot_ new_state = state.assigned(key, std::move(value), old_entry, new_entry);
+            observable::change_kind kind = old_entry ? observable::change_kind::updated : observable::change_kind::inserted;
+            changes.push_back(Change_(kind, std::move(old_entry), std::move(new_entry)));
+            return new_state;
+        }
+
+        static Change_ make_reset_change(const Snapshot_&, const Snapshot_&)
+        { return Change_(observable::change_kind::reset, typename Change_::entry_ptr(), typename Change_::entry_ptr()); }
+
+        // One change per key, in the order the keys were first changed. The change is found by comparing the entries of
+        // the key in both snapshots, so a removed and added key becomes an update, and an added and removed one disappears
+        static std::vector<Change_> compact_changes(const Snapshot_& previous, const Snapshot_& current, std::vector<Change_> changes)
+        {
+            for (const auto& c : changes)
+                if (c.get_kind() == observable::change_kind::reset)
+                    return std::vector<Change_>(1, make_reset_change(previous, current));
+
+            typename Snapshot_::key_ptr_set keys;
+            std::vector<Change_> result;
+            for (const auto& c : changes)
+            {
+                const key_type& key = c.get_key();
+                if (!keys.insert(&key).second)
+                    continue;
+
+                typename Change_::entry_ptr old_entry = previous.find_entry(key);
+                typename Change_::entry_ptr new_entry = current.find_entry(key);
+                if (old_entry == new_entry)
+                    continue;
+
+                observable::change_kind kind = !old_entry ? observable::change_kind::inserted : (!new_entry ? observable::change_kind::removed : observable::change_kind::updated);
+                result.push_back(Change_(kind, std::move(old_entry), std::move(new_entry)));
+            }
+            return result;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
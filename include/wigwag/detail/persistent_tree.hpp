@@ -0,0 +1,290 @@
+#ifndef WIGWAG_DETAIL_PERSISTENT_TREE_HPP
+#define WIGWAG_DETAIL_PERSISTENT_TREE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/intrusive_ptr.hpp>
+#include <wigwag/detail/intrusive_ref_counter.hpp>
+#include <wigwag/policies/ref_counter/atomic.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Immutable treap node. Modifications copy the path from the root to the changed node and share everything else, so a
+    // snapshot of the whole tree is just a pointer to its root
+    template < typename T_ >
+    class persistent_tree_node : public intrusive_ref_counter<wigwag::ref_counter::atomic, persistent_tree_node<T_>>
+    {
+    public:
+        using node_ptr = intrusive_ptr<const persistent_tree_node>;
+
+    private:
+        T_              _value;
+        uint32_t        _priority;
+        std::size_t     _size;
+        node_ptr        _left;
+        node_ptr        _right;
+
+    public:
+        persistent_tree_node(T_ value, uint32_t priority, node_ptr left, node_ptr right)
+            : _value(std::move(value)), _priority(priority), _size(1 + get_size(left) + get_size(right)), _left(std::move(left)), _right(std::move(right))
+        { }
+
+        const T_& get_value() const { return _value; }
+        uint32_t get_priority() const { return _priority; }
+        std::size_t get_size() const { return _size; }
+        const node_ptr& get_left() const { return _left; }
+        const node_ptr& get_right() const { return _right; }
+
+        static std::size_t get_size(const node_ptr& n) { return n ? n->_size : 0; }
+    };
+
+
+    template < typename T_ >
+    struct persistent_tree
+    {
+        using node = persistent_tree_node<T_>;
+        using node_ptr = typename node::node_ptr;
+        using node_pair = std::pair<node_ptr, node_ptr>;
+
+        static uint32_t random_priority()
+        {
+            static WIGWAG_THREAD_LOCAL uint32_t state = 2463534242u;
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        static node_ptr make_node(T_ value, uint32_t priority = random_priority(), node_ptr left = node_ptr(), node_ptr right = node_ptr())
+        { return node_ptr(new node(std::move(value), priority, std::move(left), std::move(right))); }
+
+        static node_ptr with_children(const node_ptr& n, node_ptr left, node_ptr right)
+        {
+            if (left == n->get_left() && right == n->get_right())
+                return n;
+            return make_node(n->get_value(), n->get_priority(), std::move(left), std::move(right));
+        }
+
+        static node_ptr merge(const node_ptr& a, const node_ptr& b)
+        {
+            if (!a)
+                return b;
+            if (!b)
+                return a;
+            if (a->get_priority() > b->get_priority())
+                return with_children(a, a->get_left(), merge(a->get_right(), b));
+            return with_children(b, merge(a, b->get_left()), b->get_right());
+        }
+
+        // The first `count` elements go to the first tree
+        static node_pair split_at(const node_ptr& n, std::size_t count)
+        {
+            if (!n)
+                return node_pair();
+
+            std::size_t left_size = node::get_size(n->get_left());
+            if (count <= left_size)
+            {
+                node_pair p = split_at(n->get_left(), count);
+                return node_pair(std::move(p.first), with_children(n, std::move(p.second), n->get_right()));
+            }
+            node_pair p = split_at(n->get_right(), count - left_size - 1);
+            return node_pair(with_children(n, n->get_left(), std::move(p.first)), std::move(p.second));
+        }
+
+        // The elements for which goes_left returns true go to the first tree. goes_left must be monotonic in the tree order
+        template < typename Pred_ >
+        static node_pair split_by(const node_ptr& n, const Pred_& goes_left)
+        {
+            if (!n)
+                return node_pair();
+
+            if (goes_left(n->get_value()))
+            {
+                node_pair p = split_by(n->get_right(), goes_left);
+                return node_pair(with_children(n, n->get_left(), std::move(p.first)), std::move(p.second));
+            }
+            node_pair p = split_by(n->get_left(), goes_left);
+            return node_pair(std::move(p.first), with_children(n, std::move(p.second), n->get_right()));
+        }
+
+        static const node* at(const node_ptr& root, std::size_t index)
+        {
+            const node* n = root.get();
+            while (n)
+            {
+                std::size_t left_size = node::get_size(n->get_left());
+                if (index == left_size)
+                    return n;
+                if (index < left_size)
+                    n = n->get_left().get();
+                else
+                {
+                    index -= left_size + 1;
+                    n = n->get_right().get();
+                }
+            }
+            return nullptr;
+        }
+
+        static node_ptr replace_at(const node_ptr& n, std::size_t index, T_ value)
+        {
+            std::size_t left_size = node::get_size(n->get_left());
+            if (index < left_size)
+                return with_children(n, replace_at(n->get_left(), index, std::move(value)), n->get_right());
+            if (index > left_size)
+                return with_children(n, n->get_left(), replace_at(n->get_right(), index - left_size - 1, std::move(value)));
+            return make_node(std::move(value), n->get_priority(), n->get_left(), n->get_right());
+        }
+
+        // locate(n) returns a negative number if the element is to the left of the node n, zero if it is n, and a positive
+        // number if it is to the right. Returns null if there is no such element, value is moved from only if there is
+        template < typename Locate_ >
+        static node_ptr replace(const node_ptr& n, const Locate_& locate, T_& value, node_ptr& old_node, node_ptr& new_node)
+        {
+            if (!n)
+                return node_ptr();
+
+            int c = locate(n);
+            if (c == 0)
+            {
+                old_node = n;
+                new_node = make_node(std::move(value), n->get_priority(), n->get_left(), n->get_right());
+                return new_node;
+            }
+
+            node_ptr child = replace(c < 0 ? n->get_left() : n->get_right(), locate, value, old_node, new_node);
+            if (!child)
+                return node_ptr();
+            return c < 0 ? with_children(n, std::move(child), n->get_right()) : with_children(n, n->get_left(), std::move(child));
+        }
+
+        // The element should be in the tree
+        template < typename Locate_ >
+        static node_ptr erase(const node_ptr& n, const Locate_& locate)
+        {
+            int c = locate(n);
+            if (c < 0)
+                return with_children(n, erase(n->get_left(), locate), n->get_right());
+            if (c > 0)
+                return with_children(n, n->get_left(), erase(n->get_right(), locate));
+            return merge(n->get_left(), n->get_right());
+        }
+
+        // goes_left is the same as for split_by
+        template < typename Pred_ >
+        static node_ptr insert(const node_ptr& n, T_ value, uint32_t priority, const Pred_& goes_left, node_ptr& new_node)
+        {
+            if (!n || priority > n->get_priority())
+            {
+                node_pair p = split_by(n, goes_left);
+                new_node = make_node(std::move(value), priority, std::move(p.first), std::move(p.second));
+                return new_node;
+            }
+            if (goes_left(n->get_value()))
+                return with_children(n, n->get_left(), insert(n->get_right(), std::move(value), priority, goes_left, new_node));
+            return with_children(n, insert(n->get_left(), std::move(value), priority, goes_left, new_node), n->get_right());
+        }
+
+        // Merging halves keeps the priorities random, so the result is as balanced as one built by insertions, in O(n)
+        template < typename It_ >
+        static node_ptr build(It_ first, std::size_t count)
+        {
+            if (count == 0)
+                return node_ptr();
+            if (count == 1)
+                return make_node(*first);
+
+            It_ middle = first;
+            std::advance(middle, count / 2);
+            return merge(build(first, count / 2), build(middle, count - count / 2));
+        }
+    };
+
+
+    struct persistent_tree_identity
+    {
+        template < typename T_ >
+        static const T_& project(const T_& value) { return value; }
+    };
+
+
+    // In-order iterator over a persistent tree, keeps the path from the root on its own stack
+    template < typename T_, typename Projection_ = persistent_tree_identity >
+    class persistent_tree_iterator
+    {
+        using node = persistent_tree_node<T_>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::decay<decltype(Projection_::project(std::declval<const T_&>()))>::type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+    private:
+        std::vector<const node*>    _path;
+
+    public:
+        persistent_tree_iterator() { }
+
+        explicit persistent_tree_iterator(const node* root)
+        { push_left(root); }
+
+        reference operator * () const { return Projection_::project(_path.back()->get_value()); }
+        pointer operator -> () const { return &Projection_::project(_path.back()->get_value()); }
+
+        persistent_tree_iterator& operator ++ ()
+        {
+            const node* n = _path.back();
+            _path.pop_back();
+            push_left(n->get_right().get());
+            return *this;
+        }
+
+        persistent_tree_iterator operator ++ (int)
+        {
+            persistent_tree_iterator result(*this);
+            ++*this;
+            return result;
+        }
+
+        bool operator == (const persistent_tree_iterator& other) const
+        { return _path.empty() ? other._path.empty() : (!other._path.empty() && _path.back() == other._path.back()); }
+
+        bool operator != (const persistent_tree_iterator& other) const
+        { return !(*this == other); }
+
+    private:
+        void push_left(const node* n)
+        {
+            for (; n; n = n->get_left().get())
+                _path.push_back(n);
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -13,9 +13,12 @@
 
 #include <wigwag/detail/policies/creation/policy_concept.hpp>
 #include <wigwag/detail/policies/exception_handling/policy_concept.hpp>
+#include <wigwag/detail/policies/instrumentation/policy_concept.hpp>
 #include <wigwag/detail/policies/life_assurance/policy_concept.hpp>
+#include <wigwag/detail/policies/profiling/policy_concept.hpp>
 #include <wigwag/detail/policies/ref_counter/policy_concept.hpp>
 #include <wigwag/detail/policies/state_populating/policy_concept.hpp>
+#include <wigwag/detail/policies/task_queue/policy_concept.hpp>
 #include <wigwag/detail/policies/threading/policy_concept.hpp>
 
 #endif
@@ -0,0 +1,30 @@
+#ifndef WIGWAG_DETAIL_PROBES_HPP
+#define WIGWAG_DETAIL_PROBES_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+// USDT probes (provider "wigwag") for perf and bpftrace. Defining WIGWAG_USE_USDT_PROBES=1 requires <sys/sdt.h>, but no runtime library.
+//
+// signal__emit__start(impl)             signal__emit__end(impl)
+// handler__start(impl, node)            handler__end(impl, node)
+// listenable__connect(impl, attributes) listenable__disconnect(impl, node)
+// executor__task__start(executor)       executor__task__end(executor)
+
+#if defined(WIGWAG_USE_USDT_PROBES) && WIGWAG_USE_USDT_PROBES
+#   include <sys/sdt.h>
+#   define WIGWAG_PROBE1(Name_, A1_) do { DTRACE_PROBE1(wigwag, Name_, A1_); } while (0)
+#   define WIGWAG_PROBE2(Name_, A1_, A2_) do { DTRACE_PROBE2(wigwag, Name_, A1_, A2_); } while (0)
+#else
+#   define WIGWAG_PROBE1(Name_, A1_) do { } while (0)
+#   define WIGWAG_PROBE2(Name_, A1_, A2_) do { } while (0)
+#endif
+
+#endif
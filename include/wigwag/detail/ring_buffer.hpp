@@ -0,0 +1,73 @@
+#ifndef WIGWAG_DETAIL_RING_BUFFER_HPP
+#define WIGWAG_DETAIL_RING_BUFFER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename T_ >
+    class ring_buffer
+    {
+    private:
+        std::vector<T_>     _storage;
+        std::size_t         _head;
+        std::size_t         _size;
+
+    public:
+        explicit ring_buffer(std::size_t capacity)
+            : _storage(capacity), _head(0), _size(0)
+        { WIGWAG_ASSERT(capacity > 0, "ring_buffer capacity should be positive!"); }
+
+        bool empty() const { return _size == 0; }
+        bool full() const { return _size == _storage.size(); }
+        std::size_t size() const { return _size; }
+        std::size_t capacity() const { return _storage.size(); }
+
+        T_& back() { return _storage[index(_size - 1)]; }
+
+        void push_back(T_&& val)
+        {
+            WIGWAG_ASSERT(!full(), "ring_buffer overflow!");
+            _storage[index(_size)] = std::move(val);
+            ++_size;
+        }
+
+        T_ pop_front()
+        {
+            WIGWAG_ASSERT(!empty(), "ring_buffer underflow!");
+            T_ result;
+            std::swap(result, _storage[_head]);
+            _head = index(1);
+            --_size;
+            return result;
+        }
+
+    private:
+        std::size_t index(std::size_t offset) const
+        { return (_head + offset) % _storage.size(); }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -11,6 +11,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/emission_waiter.hpp>
 #include <wigwag/handler_attributes.hpp>
 #include <wigwag/task_executor.hpp>
 #include <wigwag/token.hpp>
@@ -30,6 +31,9 @@ namespace detail
         virtual token connect(std::function<Signature_> handler, handler_attributes attributes) = 0;
         virtual token connect(std::shared_ptr<task_executor> worker, std::function<Signature_> handler, handler_attributes attributes) = 0;
 
+        virtual void add_waiter(emission_waiter<Signature_>& waiter) = 0;
+        virtual void remove_waiter(emission_waiter<Signature_>& waiter) = 0;
+
         virtual void add_ref() = 0;
         virtual void release() = 0;
     };
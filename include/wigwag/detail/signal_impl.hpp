@@ -12,10 +12,18 @@
 
 
 #include <wigwag/detail/async_handler.hpp>
+#include <wigwag/detail/deferred_handler.hpp>
+#include <wigwag/detail/emission_queue.hpp>
 #include <wigwag/detail/listenable_impl.hpp>
+#include <wigwag/detail/probes.hpp>
 #include <wigwag/detail/signal_connector_impl.hpp>
+#include <wigwag/detail/tracing.hpp>
+#include <wigwag/detail/type_expression_check.hpp>
 #include <wigwag/signal_attributes.hpp>
 
+#include <functional>
+#include <type_traits>
+
 
 namespace wigwag {
 namespace detail
@@ -23,38 +31,73 @@ namespace detail
 
 #include <wigwag/detail/disable_warnings.hpp>
 
+    WIGWAG_DECLARE_TYPE_EXPRESSION_CHECK(populates_from_snapshot, std::declval<const T_&>().take_snapshot());
+
+
     template <
             typename Signature_,
             typename ExceptionHandlingPolicy_,
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename ProfilingPolicy_
         >
     class signal_impl
         :   public signal_connector_impl<Signature_>,
-            private listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>
+            private listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, typename ProfilingPolicy_::template profiler<Signature_>>
     {
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using listenable_base = listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>;
+        using listenable_base = listenable_impl<std::function<Signature_>, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, typename ProfilingPolicy_::template profiler<Signature_>>;
 
     private:
         using handler_type = std::function<Signature_>;
 
         using handler_node = typename listenable_base::handler_node;
+        using handler_processor = typename listenable_base::handler_processor;
         using lock_primitive = typename listenable_base::lock_primitive;
         using life_checker = typename listenable_base::life_checker;
         using execution_guard = typename listenable_base::execution_guard;
 
+        using profiler = typename listenable_base::profiler;
+        using profiled_emission = typename profiler::emission;
+        using profiled_handler = typename profiler::handler_scope;
+
+        using waiters_container = intrusive_list<emission_waiter<Signature_>>;
+
+    private:
+        bool                _queued_emission;
+        waiters_container   _waiters;
+
     public:
+        static const bool relocatable = listenable_base::relocatable;
+
         template < typename... Args_, bool E_ = std::is_constructible<listenable_base, Args_...>::value, typename = typename std::enable_if<E_>::type >
         signal_impl(Args_&&... args)
-            : listenable_base(std::forward<Args_>(args)...)
+            : listenable_base(std::forward<Args_>(args)...), _queued_emission(false), _waiters()
+        { }
+
+        // The waiters keep owning pointers to the implementation, so an implementation that is relocated has none
+        signal_impl(typename listenable_base::relocation_tag t, const signal_impl& other)
+            : listenable_base(t, other), _queued_emission(other._queued_emission), _waiters()
         { }
 
         void finalize_nodes()
         { listenable_base::finalize_nodes(); }
 
+        bool has_nodes() const
+        { return listenable_base::has_nodes(); }
+
+        bool is_emitting() const
+        { return listenable_base::is_emitting(); }
+
+        signal_impl* relocate()
+        {
+            signal_impl* result = new signal_impl(typename listenable_base::relocation_tag(), *this);
+            listenable_base::move_nodes_to(*result);
+            return result;
+        }
+
         const lock_primitive& get_lock_primitive() const
         { return listenable_base::get_lock_primitive(); }
 
@@ -66,6 +109,9 @@ namespace detail
             if (contains_flag(this->get_attributes(), signal_attributes::connect_async_only))
                 WIGWAG_THROW("The signal restrains connecting synchronous handlers!");
 
+            if (populates_from_snapshot<handler_processor>::value && !contains_flag(attributes, handler_attributes::suppress_populator) && this->get_handler_processor().has_populate_state())
+                return connect_from_snapshot(attributes, [&](life_checker) { return std::move(handler); }, std::integral_constant<bool, populates_from_snapshot<handler_processor>::value>());
+
             return listenable_base::connect(std::move(handler), attributes);
         }
 
@@ -74,28 +120,196 @@ namespace detail
             if (contains_flag(this->get_attributes(), signal_attributes::connect_sync_only))
                 WIGWAG_THROW("The signal restrains connecting asynchronous handlers!");
 
+            if (populates_from_snapshot<handler_processor>::value && !contains_flag(attributes, handler_attributes::suppress_populator) && this->get_handler_processor().has_populate_state())
+                return connect_async_from_snapshot(attributes, std::move(worker), std::move(handler), std::integral_constant<bool, populates_from_snapshot<handler_processor>::value>());
+
+            if (this->appends_lock_free())
+                return this->create_node(attributes, [&](life_checker lc) { return handler_type(async_handler<Signature_, LifeAssurancePolicy_>(std::move(worker), std::move(lc), std::move(handler), contains_flag(attributes, handler_attributes::inline_if_current))); });
+
             this->get_lock_primitive().lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
 
             return this->create_node(attributes,
                     [&](life_checker lc) {
-                        async_handler<Signature_, LifeAssurancePolicy_> real_handler(std::move(worker), std::move(lc), std::move(handler));
+                        async_handler<Signature_, LifeAssurancePolicy_> real_handler(std::move(worker), std::move(lc), std::move(handler), contains_flag(attributes, handler_attributes::inline_if_current));
                         if (!contains_flag(attributes, handler_attributes::suppress_populator) && this->get_handler_processor().has_populate_state())
+                        {
+                            async_emission_suspender s;
                             this->get_exception_handler().handle_exceptions([&] { this->get_handler_processor().populate_state(real_handler); });
+                        }
                         return real_handler;
                     });
         }
 
+        virtual void add_waiter(emission_waiter<Signature_>& waiter)
+        {
+            this->get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+            _waiters.push_back(waiter);
+        }
+
+        virtual void remove_waiter(emission_waiter<Signature_>& waiter)
+        {
+            this->get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+            _waiters.erase(waiter);
+        }
+
         template < typename... Args_ >
         void invoke(Args_&&... args)
+        {
+            if (_queued_emission)
+                invoke_queued(std::false_type(), args...);
+            else
+                invoke_impl(std::false_type(), args...);
+        }
+
+        // Passes the arguments to all the handlers but the last live one as lvalues, and forwards them to the last one
+        template < typename... Args_ >
+        void invoke_move(Args_&&... args)
+        {
+            if (_queued_emission)
+                invoke_queued(std::true_type(), std::forward<Args_>(args)...);
+            else
+                invoke_impl(std::true_type(), std::forward<Args_>(args)...);
+        }
+
+    private:
+        // The node is added together with taking the snapshot, but only queues the events until the snapshot is populated
+        // outside the lock, so the handler gets every event that is not in the snapshot exactly once
+        template < typename MakeHandlerFunc_ >
+        token connect_from_snapshot(handler_attributes attributes, const MakeHandlerFunc_& make_handler, std::true_type)
+        {
+            std::function<void(const handler_type&)> populator;
+            deferred_handler<Signature_> deferred;
+            token result;
+
+            {
+                this->get_lock_primitive().lock_nonrecursive();
+                auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+
+                populator = this->get_handler_processor().take_snapshot();
+                result = this->create_node(attributes,
+                        [&](life_checker lc) {
+                            deferred.set_handler(make_handler(std::move(lc)));
+                            return handler_type(deferred);
+                        });
+            }
+
+            {
+                async_emission_suspender s;
+                this->get_exception_handler().handle_exceptions([&] { populator(deferred.get_handler()); });
+            }
+
+            this->get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+            deferred.activate([&](const std::function<void()>& f) { this->get_exception_handler().handle_exceptions(f); });
+
+            return result;
+        }
+
+        template < typename MakeHandlerFunc_ >
+        token connect_from_snapshot(handler_attributes, const MakeHandlerFunc_&, std::false_type)
+        { WIGWAG_THROW("Unexpected connect_from_snapshot call!"); }
+
+        // The snapshot is passed to the worker as a single task, and the node is added under the same lock, so the tasks
+        // for the subsequent emissions are queued after it
+        token connect_async_from_snapshot(handler_attributes attributes, std::shared_ptr<task_executor> worker, handler_type handler, std::true_type)
+        {
+            this->get_lock_primitive().lock_nonrecursive();
+            auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_nonrecursive(); } );
+
+            auto populator = this->get_handler_processor().take_snapshot();
+            return this->create_node(attributes,
+                    [&](life_checker lc) {
+                        async_handler<Signature_, LifeAssurancePolicy_> real_handler(std::move(worker), std::move(lc), std::move(handler), contains_flag(attributes, handler_attributes::inline_if_current));
+                        real_handler.add_populating_task(std::move(populator));
+                        return real_handler;
+                    });
+        }
+
+        token connect_async_from_snapshot(handler_attributes, std::shared_ptr<task_executor>, handler_type, std::false_type)
+        { WIGWAG_THROW("Unexpected connect_async_from_snapshot call!"); }
+
+        // An emission made from the handlers of another queued emission on this thread copies the arguments and is
+        // executed after the outermost one returns
+        template < typename MoveIntoLast_, typename... Args_ >
+        void invoke_queued(MoveIntoLast_, Args_&&... args)
+        {
+            emission_queue* q = emission_queue::get_current();
+            if (q)
+            {
+                this->add_ref();
+                q->enqueue(std::bind(&signal_impl::invoke_postponed<typename std::decay<Args_>::type...>, intrusive_ptr<signal_impl>(this), std::forward<Args_>(args)...));
+                return;
+            }
+
+            emission_queue::run([&] { this->invoke_impl(MoveIntoLast_(), std::forward<Args_>(args)...); });
+        }
+
+        template < typename... Args_ >
+        static void invoke_postponed(const intrusive_ptr<signal_impl>& self, Args_&... args)
+        { self->invoke_impl(std::false_type(), args...); }
+
+        template < typename MoveIntoLast_, typename... Args_ >
+        void invoke_impl(MoveIntoLast_, Args_&&... args)
         {
             this->get_lock_primitive().lock_recursive();
             auto sg = detail::at_scope_exit([&] { this->get_lock_primitive().unlock_recursive(); } );
 
+            WIGWAG_PROBE1(signal__emit__start, this);
+            auto probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE1(signal__emit__end, this); } );
+            WIGWAG_TRACE_SCOPE("signal emit", this);
+
+            this->emission_started();
+            auto depth_sg = detail::at_scope_exit([&] { this->emission_finished(); } );
+
+            profiled_emission pe(this->get_profiler());
+
+            this->add_pending_nodes();
+            if (!_waiters.empty())
+            {
+                invoke_handlers(pe, std::false_type(), args...);
+                notify_waiters(args...);
+            }
+            else
+                invoke_handlers(pe, MoveIntoLast_(), std::forward<Args_>(args)...);
+        }
+
+        // The waiters that are added while the others are notified wait for the next emission
+        template < typename... Args_ >
+        void notify_waiters(Args_&... args)
+        {
+            waiters_container waiters;
+            _waiters.move_to(waiters);
+            auto sg = detail::at_scope_exit([&] { waiters.move_to(_waiters); } );
+
+            while (!waiters.empty())
+            {
+                emission_waiter<Signature_>& w = *waiters.begin();
+                waiters.erase(w);
+                this->get_exception_handler().handle_exceptions([&] { w.notify(args...); });
+            }
+        }
+
+        template < typename MoveIntoLast_, typename... Args_ >
+        void invoke_handlers(profiled_emission& pe, MoveIntoLast_, Args_&&... args)
+        {
             if (this->_handlers.empty())
                 return;
             auto it = this->_handlers.begin(), e = this->_handlers.pre_end();
 
+            const handler_node* last_live = nullptr;
+            if (MoveIntoLast_::value)
+            {
+                auto l = e;
+                while (l != it && l->should_be_finalized())
+                    --l;
+                last_live = &*l;
+            }
+
+            async_emission_scope<Signature_> aes;
+
             bool last_iter = false;
             while (!last_iter)
             {
@@ -109,13 +323,24 @@ namespace detail
 
                 execution_guard g(listenable_base::get_life_assurance_shared_data(), it->get_life_assurance());
                 if (g.is_alive())
-                    this->get_exception_handler().handle_exceptions(it->get_handler(), std::forward<Args_>(args)...);
+                {
+                    WIGWAG_PROBE2(handler__start, this, &*it);
+                    auto handler_probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE2(handler__end, this, &*it); } );
+                    WIGWAG_TRACE_SCOPE("handler", &*it);
+                    profiled_handler ph(pe, it->get_profile_data());
+                    if (MoveIntoLast_::value && &*it == last_live)
+                        this->get_exception_handler().handle_exceptions(it->get_handler(), std::forward<Args_>(args)...);
+                    else
+                        this->get_exception_handler().handle_exceptions(it->get_handler(), args...);
+                }
                 ++it;
             }
         }
 
     protected:
         virtual signal_attributes get_attributes() const { return signal_attributes::none; }
+
+        void set_queued_emission(bool queued_emission) { _queued_emission = queued_emission; }
     };
 
 
@@ -125,12 +350,13 @@ namespace detail
             typename ThreadingPolicy_,
             typename StatePopulatingPolicy_,
             typename LifeAssurancePolicy_,
-            typename RefCounterPolicy_
+            typename RefCounterPolicy_,
+            typename ProfilingPolicy_
         >
-    class signal_with_attributes_impl : public signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>
+    class signal_with_attributes_impl : public signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, ProfilingPolicy_>
     {
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using base = signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_>;
+        using base = signal_impl<Signature_, ExceptionHandlingPolicy_, ThreadingPolicy_, StatePopulatingPolicy_, LifeAssurancePolicy_, RefCounterPolicy_, ProfilingPolicy_>;
 
     private:
         signal_attributes   _attributes;
@@ -143,7 +369,7 @@ namespace detail
         template < typename... Args_ >
         signal_with_attributes_impl(signal_attributes attributes, Args_&&... args)
             : base(std::forward<Args_>(args)...), _attributes(attributes)
-        { }
+        { this->set_queued_emission(contains_flag(attributes, signal_attributes::queued_emission)); }
 
     protected:
         virtual signal_attributes get_attributes() const { return _attributes; }
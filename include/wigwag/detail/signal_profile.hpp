@@ -0,0 +1,210 @@
+#ifndef WIGWAG_DETAIL_SIGNAL_PROFILE_HPP
+#define WIGWAG_DETAIL_SIGNAL_PROFILE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/histogram.hpp>
+#include <wigwag/detail/tsc.hpp>
+#include <wigwag/signal_profiling_snapshot.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    class signal_profile;
+
+
+    class signal_profile_registry
+    {
+    private:
+        std::mutex                          _mutex;
+        std::set<const signal_profile*>     _profiles;
+
+    public:
+        static signal_profile_registry& instance()
+        {
+            static signal_profile_registry inst;
+            return inst;
+        }
+
+        void add(const signal_profile* p)
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _profiles.insert(p);
+        }
+
+        void remove(const signal_profile* p)
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            _profiles.erase(p);
+        }
+
+        std::vector<signal_profiling_snapshot> get_snapshots();
+    };
+
+
+    // Lives in the handler node, so that a sampled emission does not look it up. Written by the emissions, that are
+    // serialized by the signal lock, and read by the snapshots
+    class handler_profile
+    {
+        friend class signal_profile;
+
+    private:
+        std::atomic<uint64_t>   _calls;
+        std::atomic<uint64_t>   _ticks;
+        uint64_t                _id;
+
+    public:
+        handler_profile() : _calls(0), _ticks(0), _id(0) { }
+
+        handler_profile(const handler_profile&) = delete;
+        handler_profile& operator = (const handler_profile&) = delete;
+
+        void record(uint64_t ticks)
+        {
+            _calls.fetch_add(1, std::memory_order_relaxed);
+            _ticks.fetch_add(ticks, std::memory_order_relaxed);
+        }
+    };
+
+
+    class signal_profile
+    {
+        struct handler_totals
+        {
+            uint64_t    id;
+            uint64_t    calls;
+            uint64_t    ticks;
+
+            handler_totals(uint64_t id, uint64_t calls, uint64_t ticks) : id(id), calls(calls), ticks(ticks) { }
+        };
+
+        // Only the slowest removed handlers are kept, so that the signals with churning handlers do not grow
+        static const std::size_t max_removed_handlers = 64;
+
+    private:
+        std::string                             _signature;
+        std::atomic<uint64_t>                   _emit_count;
+        histogram                               _invoke_ticks;
+        std::atomic<std::size_t>                _handlers_count;
+        mutable std::mutex                      _handlers_mutex;
+        std::set<const handler_profile*>        _handlers;
+        std::vector<handler_totals>             _removed_handlers;
+
+    public:
+        explicit signal_profile(std::string signature)
+            : _signature(std::move(signature)), _emit_count(0), _handlers_count(0)
+        { signal_profile_registry::instance().add(this); }
+
+        ~signal_profile()
+        { signal_profile_registry::instance().remove(this); }
+
+        signal_profile(const signal_profile&) = delete;
+        signal_profile& operator = (const signal_profile&) = delete;
+
+        uint64_t count_emission()
+        { return _emit_count.fetch_add(1, std::memory_order_relaxed); }
+
+        void emission_sampled(uint64_t ticks, std::size_t handlers_count)
+        {
+            _invoke_ticks.record(ticks);
+            _handlers_count.store(handlers_count, std::memory_order_relaxed);
+        }
+
+        // The ids are global, so that a handler keeps its id when its node is relocated to another signal implementation
+        void handler_added(handler_profile& h)
+        {
+            static std::atomic<uint64_t> next_id(0);
+            h._id = next_id.fetch_add(1, std::memory_order_relaxed) + 1;
+
+            std::lock_guard<std::mutex> l(_handlers_mutex);
+            _handlers.insert(&h);
+        }
+
+        void handler_moved(handler_profile& h, signal_profile& from)
+        {
+            {
+                std::lock_guard<std::mutex> l(from._handlers_mutex);
+                from._handlers.erase(&h);
+            }
+
+            std::lock_guard<std::mutex> l(_handlers_mutex);
+            _handlers.insert(&h);
+        }
+
+        void handler_removed(handler_profile& h)
+        {
+            handler_totals totals(h._id, h._calls.load(std::memory_order_relaxed), h._ticks.load(std::memory_order_relaxed));
+
+            std::lock_guard<std::mutex> l(_handlers_mutex);
+            _handlers.erase(&h);
+            if (totals.calls == 0)
+                return;
+
+            if (_removed_handlers.size() < max_removed_handlers)
+            {
+                _removed_handlers.push_back(totals);
+                return;
+            }
+
+            auto fastest = std::min_element(_removed_handlers.begin(), _removed_handlers.end(),
+                [](const handler_totals& l, const handler_totals& r) { return l.ticks < r.ticks; });
+            if (fastest->ticks < totals.ticks)
+                *fastest = totals;
+        }
+
+        signal_profiling_snapshot get_snapshot() const
+        {
+            double ns_per_tick = tsc::ns_per_tick();
+
+            std::vector<handler_profiling_snapshot> handlers;
+            {
+                std::lock_guard<std::mutex> l(_handlers_mutex);
+                handlers.reserve(_handlers.size() + _removed_handlers.size());
+                for (const handler_profile* h : _handlers)
+                    handlers.push_back(handler_profiling_snapshot(h->_id, h->_calls.load(std::memory_order_relaxed), h->_ticks.load(std::memory_order_relaxed) * ns_per_tick));
+                for (const handler_totals& h : _removed_handlers)
+                    handlers.push_back(handler_profiling_snapshot(h.id, h.calls, h.ticks * ns_per_tick));
+            }
+            std::sort(handlers.begin(), handlers.end(),
+                [](const handler_profiling_snapshot& l, const handler_profiling_snapshot& r) { return l.get_total_ns() > r.get_total_ns(); });
+
+            return signal_profiling_snapshot(_signature, this, _emit_count.load(std::memory_order_relaxed), _invoke_ticks.get_snapshot(),
+                ns_per_tick, _handlers_count.load(std::memory_order_relaxed), std::move(handlers));
+        }
+    };
+
+
+    inline std::vector<signal_profiling_snapshot> signal_profile_registry::get_snapshots()
+    {
+        std::lock_guard<std::mutex> l(_mutex);
+        std::vector<signal_profiling_snapshot> result;
+        result.reserve(_profiles.size());
+        for (auto p : _profiles)
+            result.push_back(p->get_snapshot());
+        return result;
+    }
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
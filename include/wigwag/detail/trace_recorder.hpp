@@ -0,0 +1,251 @@
+#ifndef WIGWAG_DETAIL_TRACE_RECORDER_HPP
+#define WIGWAG_DETAIL_TRACE_RECORDER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct trace_event
+    {
+        const char*     name;
+        const void*     object;
+        uint64_t        id;
+        uint64_t        timestamp_ns;
+        char            phase;
+    };
+
+
+    // Single writer (the owning thread), single reader (the trace writer, under the recorder mutex)
+    class trace_thread_buffer
+    {
+        struct chunk
+        {
+            static const std::size_t capacity = 4096;
+
+            trace_event                 events[capacity];
+            std::atomic<std::size_t>    size;
+            std::atomic<chunk*>         next;
+
+            chunk() : size(0), next(nullptr) { }
+        };
+
+    private:
+        unsigned            _thread_id;
+        chunk*              _write_chunk;
+        chunk*              _read_chunk;
+        std::size_t         _read_pos;
+        std::atomic<bool>   _finished;
+
+    public:
+        explicit trace_thread_buffer(unsigned thread_id)
+            : _thread_id(thread_id), _write_chunk(new chunk), _read_chunk(_write_chunk), _read_pos(0), _finished(false)
+        { }
+
+        ~trace_thread_buffer()
+        {
+            for (chunk* c = _read_chunk; c; )
+            {
+                chunk* next = c->next.load(std::memory_order_relaxed);
+                delete c;
+                c = next;
+            }
+        }
+
+        trace_thread_buffer(const trace_thread_buffer&) = delete;
+        trace_thread_buffer& operator = (const trace_thread_buffer&) = delete;
+
+        unsigned get_thread_id() const { return _thread_id; }
+
+        // Called by the writer when its thread exits. The events pushed before are visible to the reader that sees the flag
+        void finish() { _finished.store(true, std::memory_order_release); }
+        bool finished() const { return _finished.load(std::memory_order_acquire); }
+
+        void push(const trace_event& e)
+        {
+            std::size_t n = _write_chunk->size.load(std::memory_order_relaxed);
+            if (n == chunk::capacity)
+            {
+                chunk* c = new chunk;
+                _write_chunk->next.store(c, std::memory_order_release);
+                _write_chunk = c;
+                n = 0;
+            }
+            _write_chunk->events[n] = e;
+            _write_chunk->size.store(n + 1, std::memory_order_release);
+        }
+
+        // Passes the events that were not consumed yet to f, and frees the chunks that the writer will not touch anymore
+        template < typename Func_ >
+        void consume(const Func_& f)
+        {
+            while (true)
+            {
+                std::size_t n = _read_chunk->size.load(std::memory_order_acquire);
+                for (; _read_pos < n; ++_read_pos)
+                    f(_read_chunk->events[_read_pos]);
+
+                chunk* next = _read_chunk->next.load(std::memory_order_acquire);
+                if (n < chunk::capacity || !next)
+                    break;
+
+                delete _read_chunk;
+                _read_chunk = next;
+                _read_pos = 0;
+            }
+        }
+    };
+
+
+#if WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS
+    // Hands the buffer of the thread back to the recorder when the thread exits
+    struct trace_thread_buffer_owner
+    {
+        trace_thread_buffer**   current = nullptr;
+
+        ~trace_thread_buffer_owner()
+        {
+            if (!current || !*current)
+                return;
+            (*current)->finish();
+            *current = nullptr;
+        }
+    };
+#endif
+
+
+    class trace_recorder
+    {
+        using clock = std::chrono::steady_clock;
+
+    private:
+        std::atomic<bool>                                   _enabled;
+        std::atomic<uint64_t>                               _next_flow_id;
+        clock::time_point                                   _origin;
+        std::mutex                                          _mutex;
+        std::vector<std::unique_ptr<trace_thread_buffer>>   _buffers;
+        unsigned                                            _next_thread_id;
+
+    public:
+        trace_recorder()
+            : _enabled(false), _next_flow_id(1), _origin(clock::now()), _next_thread_id(1)
+        { }
+
+        // Never destroyed, so that the objects that are destroyed at exit may still record events
+        static trace_recorder& instance()
+        {
+            static trace_recorder* inst = new trace_recorder;
+            return *inst;
+        }
+
+        bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+        void set_enabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+        uint64_t next_flow_id()
+        { return _next_flow_id.fetch_add(1, std::memory_order_relaxed); }
+
+        void record(char phase, const char* name, const void* object, uint64_t id = 0)
+        {
+            trace_event e;
+            e.name = name;
+            e.object = object;
+            e.id = id;
+            e.timestamp_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _origin).count();
+            e.phase = phase;
+            get_thread_buffer().push(e);
+        }
+
+        // Writes the events recorded since the previous call in the Chrome trace event format, and frees the buffers of the exited threads
+        void write_chrome_trace(std::ostream& os)
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+            bool first = true;
+            for (auto it = _buffers.begin(); it != _buffers.end();)
+            {
+                // Checked before consuming, so that the last events of an exited thread are written below
+                bool finished = (*it)->finished();
+
+                unsigned tid = (*it)->get_thread_id();
+                (*it)->consume([&](const trace_event& e) {
+                        os << (first ? "\n" : ",\n");
+                        first = false;
+                        write_event(os, tid, e);
+                    });
+
+                if (finished)
+                    it = _buffers.erase(it);
+                else
+                    ++it;
+            }
+            os << "\n]}\n";
+        }
+
+    private:
+        trace_thread_buffer& get_thread_buffer()
+        {
+            static WIGWAG_THREAD_LOCAL trace_thread_buffer* buffer = nullptr;
+            if (!buffer)
+            {
+                {
+                    std::lock_guard<std::mutex> l(_mutex);
+                    _buffers.push_back(std::unique_ptr<trace_thread_buffer>(new trace_thread_buffer(_next_thread_id++)));
+                    buffer = _buffers.back().get();
+                }
+#if WIGWAG_HAS_THREAD_LOCAL_DESTRUCTORS
+                static thread_local trace_thread_buffer_owner owner;
+                owner.current = &buffer;
+#endif
+            }
+            return *buffer;
+        }
+
+        static void write_event(std::ostream& os, unsigned tid, const trace_event& e)
+        {
+            os << "{\"name\":\"";
+            for (const char* c = e.name; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    os << '\\';
+                os << *c;
+            }
+            os << "\",\"cat\":\"wigwag\",\"ph\":\"" << e.phase << "\",\"pid\":1,\"tid\":" << tid
+                << ",\"ts\":" << e.timestamp_ns / 1000 << "." << (char)('0' + e.timestamp_ns / 100 % 10) << (char)('0' + e.timestamp_ns / 10 % 10) << (char)('0' + e.timestamp_ns % 10);
+            if (e.phase == 's' || e.phase == 'f')
+                os << ",\"id\":" << e.id;
+            if (e.phase == 'f')
+                os << ",\"bp\":\"e\"";
+            if (e.object)
+                os << ",\"args\":{\"object\":\"" << e.object << "\"}";
+            os << "}";
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
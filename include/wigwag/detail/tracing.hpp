@@ -0,0 +1,115 @@
+#ifndef WIGWAG_DETAIL_TRACING_HPP
+#define WIGWAG_DETAIL_TRACING_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+// Chrome trace hooks. They are compiled in only when WIGWAG_USE_CHROME_TRACING=1, and record events only between tracing::start() and tracing::stop()
+
+#include <type_traits>
+#include <utility>
+
+#if defined(WIGWAG_USE_CHROME_TRACING) && WIGWAG_USE_CHROME_TRACING
+#   include <wigwag/detail/at_scope_exit.hpp>
+#   include <wigwag/detail/trace_recorder.hpp>
+#endif
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+#if defined(WIGWAG_USE_CHROME_TRACING) && WIGWAG_USE_CHROME_TRACING
+
+    class trace_scope
+    {
+    private:
+        const char*     _name;
+        const void*     _object;
+        bool            _recorded;
+
+    public:
+        trace_scope(const char* name, const void* object)
+            : _name(name), _object(object), _recorded(trace_recorder::instance().enabled())
+        {
+            if (_recorded)
+                trace_recorder::instance().record('B', _name, _object);
+        }
+
+        ~trace_scope()
+        {
+            if (_recorded)
+                trace_recorder::instance().record('E', _name, _object);
+        }
+
+        trace_scope(const trace_scope&) = delete;
+        trace_scope& operator = (const trace_scope&) = delete;
+    };
+
+
+    // Connects the place where a task was enqueued with the place where it is executed by a flow event
+    template < typename Func_ >
+    class traced_task
+    {
+    private:
+        const char*     _name;
+        uint64_t        _flow_id;
+        Func_           _func;
+
+    public:
+        traced_task(const char* name, Func_ func)
+            : _name(name), _flow_id(0), _func(std::move(func))
+        {
+            trace_recorder& r = trace_recorder::instance();
+            if (!r.enabled())
+                return;
+            _flow_id = r.next_flow_id();
+            r.record('s', _name, nullptr, _flow_id);
+        }
+
+        void operator() ()
+        {
+            trace_recorder& r = trace_recorder::instance();
+            bool recorded = _flow_id != 0 && r.enabled();
+            if (recorded)
+            {
+                r.record('B', _name, nullptr);
+                r.record('f', _name, nullptr, _flow_id);
+            }
+            auto sg = at_scope_exit([&] { if (recorded) r.record('E', _name, nullptr); });
+            _func();
+        }
+    };
+
+    template < typename Func_ >
+    traced_task<typename std::decay<Func_>::type> make_traced_task(const char* name, Func_&& func)
+    { return traced_task<typename std::decay<Func_>::type>(name, std::forward<Func_>(func)); }
+
+#   define WIGWAG_TRACE_SCOPE_CONCAT_IMPL(A_, B_) A_##B_
+#   define WIGWAG_TRACE_SCOPE_CONCAT(A_, B_) WIGWAG_TRACE_SCOPE_CONCAT_IMPL(A_, B_)
+#   define WIGWAG_TRACE_SCOPE(Name_, Object_) ::wigwag::detail::trace_scope WIGWAG_TRACE_SCOPE_CONCAT(wigwag_trace_scope_, __LINE__)(Name_, Object_)
+
+#else
+
+    template < typename Func_ >
+    Func_&& make_traced_task(const char*, Func_&& func)
+    { return std::forward<Func_>(func); }
+
+#   define WIGWAG_TRACE_SCOPE(Name_, Object_) do { } while (0)
+
+#endif
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
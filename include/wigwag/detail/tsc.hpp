@@ -0,0 +1,75 @@
+#ifndef WIGWAG_DETAIL_TSC_HPP
+#define WIGWAG_DETAIL_TSC_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <chrono>
+#include <cstdint>
+
+#if (defined(__GNUC__) || defined(__clang)) && (defined(__x86_64__) || defined(__i386__))
+#   include <x86intrin.h>
+#   define WIGWAG_HAS_RDTSC 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#   define WIGWAG_HAS_RDTSC 1
+#else
+#   define WIGWAG_HAS_RDTSC 0
+#endif
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Cheap timestamps for profiling. Falls back to steady_clock nanoseconds where there is no TSC
+    struct tsc
+    {
+        static uint64_t now()
+        {
+#if WIGWAG_HAS_RDTSC
+            return __rdtsc();
+#else
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+        }
+
+        static double ns_per_tick()
+        {
+            static const double result = calibrate();
+            return result;
+        }
+
+    private:
+        static double calibrate()
+        {
+#if WIGWAG_HAS_RDTSC
+            using clock = std::chrono::steady_clock;
+
+            clock::time_point start = clock::now();
+            uint64_t start_ticks = now();
+            while (clock::now() - start < std::chrono::milliseconds(10))
+                ;
+            uint64_t end_ticks = now();
+            double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+            return end_ticks > start_ticks ? ns / (end_ticks - start_ticks) : 1.0;
+#else
+            return 1.0;
+#endif
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
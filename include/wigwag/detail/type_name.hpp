@@ -0,0 +1,54 @@
+#ifndef WIGWAG_DETAIL_TYPE_NAME_HPP
+#define WIGWAG_DETAIL_TYPE_NAME_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <string>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Does not need RTTI: the name is extracted from the pretty function name
+    template < typename T_ >
+    std::string get_type_name()
+    {
+#if defined(__GNUC__) || defined(__clang)
+        std::string s = __PRETTY_FUNCTION__;
+        std::string::size_type begin = s.find("T_ = ");
+        if (begin == std::string::npos)
+            return s;
+        begin += 5;
+        std::string::size_type end = s.find(';', begin);
+        if (end == std::string::npos)
+            end = s.rfind(']');
+        return s.substr(begin, end - begin);
+#elif defined(_MSC_VER)
+        std::string s = __FUNCSIG__;
+        std::string::size_type begin = s.find("get_type_name<");
+        std::string::size_type end = s.rfind(">(void)");
+        if (begin == std::string::npos || end == std::string::npos)
+            return s;
+        begin += 14;
+        return s.substr(begin, end - begin);
+#else
+        return "<unknown>";
+#endif
+    }
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef WIGWAG_EMISSION_AWAITER_HPP
+#define WIGWAG_EMISSION_AWAITER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#if WIGWAG_HAS_COROUTINES
+
+#include <wigwag/detail/emission_waiter.hpp>
+#include <wigwag/detail/intrusive_ptr.hpp>
+#include <wigwag/detail/signal_connector_impl.hpp>
+#include <wigwag/task_executor.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    namespace detail
+    {
+        template < typename... ArgTypes_ >
+        struct emission_result
+        {
+            using type = std::tuple<ArgTypes_...>;
+            static type get(std::tuple<ArgTypes_...>&& args) { return std::move(args); }
+        };
+
+        template < typename ArgType_ >
+        struct emission_result<ArgType_>
+        {
+            using type = ArgType_;
+            static type get(std::tuple<ArgType_>&& args) { return std::get<0>(std::move(args)); }
+        };
+
+        template < >
+        struct emission_result<>
+        {
+            using type = void;
+            static void get(std::tuple<>&&) { }
+        };
+    }
+
+
+    template < typename Signature_ >
+    class emission_awaiter;
+
+    // co_await suspends the coroutine until the next emission and returns its arguments: nothing, the only argument or a
+    // tuple of them. The awaiter is linked into the signal instead of a handler node, so awaiting does not allocate.
+    // The coroutine is resumed inside the emission, like a synchronous handler, unless a worker is specified and the
+    // emission happens elsewhere, then a task on the worker resumes it. A coroutine that is destroyed while waiting is
+    // removed from the signal, and the one that waits for a destroyed signal is never resumed
+    template < typename... ArgTypes_ >
+    class emission_awaiter<void(ArgTypes_...)> : private detail::emission_waiter<void(ArgTypes_...)>
+    {
+        using impl_type = detail::signal_connector_impl<void(ArgTypes_...)>;
+        using impl_type_ptr = detail::intrusive_ptr<impl_type>;
+        using arguments = std::tuple<typename std::decay<ArgTypes_>::type...>;
+        using result = detail::emission_result<typename std::decay<ArgTypes_>::type...>;
+
+        struct resume_task
+        {
+            std::coroutine_handle<>     handle;
+
+            void operator() () const { handle.resume(); }
+        };
+
+    private:
+        impl_type_ptr                   _impl;
+        std::shared_ptr<task_executor>  _worker;
+        std::coroutine_handle<>         _continuation;
+        std::optional<arguments>        _args;
+        std::atomic<bool>               _notified;
+
+    public:
+        emission_awaiter(impl_type_ptr impl, std::shared_ptr<task_executor> worker)
+            : _impl(std::move(impl)), _worker(std::move(worker)), _continuation(), _args(), _notified(false)
+        { }
+
+        // The signal unlinks the awaiter before notifying it, so the lock is only needed if the coroutine did not get its emission
+        ~emission_awaiter()
+        {
+            if (_continuation && !_notified.load(std::memory_order_acquire))
+                _impl->remove_waiter(*this);
+        }
+
+        emission_awaiter(const emission_awaiter&) = delete;
+        emission_awaiter& operator = (const emission_awaiter&) = delete;
+
+        bool await_ready() const noexcept
+        { return false; }
+
+        // Nothing may touch the awaiter once it is added, an emission on another thread may resume the coroutine right away
+        void await_suspend(std::coroutine_handle<> continuation)
+        {
+            _continuation = continuation;
+            _impl->add_waiter(*this);
+        }
+
+        typename result::type await_resume()
+        { return result::get(std::move(*_args)); }
+
+    private:
+        virtual void notify(ArgTypes_... args)
+        {
+            _args.emplace(args...);
+            _notified.store(true, std::memory_order_release);
+
+            if (_worker && !_worker->is_current())
+                _worker->add_task(resume_task{_continuation});
+            else
+                _continuation.resume();
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef WIGWAG_EMISSION_STREAM_HPP
+#define WIGWAG_EMISSION_STREAM_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#if WIGWAG_HAS_COROUTINES
+
+#include <wigwag/detail/concurrent_ring_buffer.hpp>
+#include <wigwag/detail/signal_connector_impl.hpp>
+#include <wigwag/emission_awaiter.hpp>
+#include <wigwag/handler_attributes.hpp>
+#include <wigwag/task_executor.hpp>
+#include <wigwag/token.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // What an emission_stream does with an emission when its buffer is full
+    enum class stream_overflow
+    {
+        drop_newest,
+        drop_oldest
+    };
+
+
+    template < typename Signature_ >
+    class emission_stream;
+
+    // Connects to the signal once and buffers the arguments of the emissions in a bounded lock-free ring, so a consumer
+    // coroutine may lag behind the emissions. co_await next() returns the oldest buffered emission and suspends only if
+    // there is none. A suspended consumer is resumed once for all the emissions that arrive before it runs: inside the
+    // emission, or by a task on the worker if it is specified and the emission happens elsewhere.
+    // There should be a single consumer, and the stream should not be destroyed while it waits
+    template < typename... ArgTypes_ >
+    class emission_stream<void(ArgTypes_...)>
+    {
+        using impl_type = detail::signal_connector_impl<void(ArgTypes_...)>;
+        using arguments = std::tuple<typename std::decay<ArgTypes_>::type...>;
+        using result = detail::emission_result<typename std::decay<ArgTypes_>::type...>;
+
+    public:
+        class awaiter
+        {
+        private:
+            emission_stream&            _stream;
+            std::optional<arguments>    _args;
+
+        public:
+            explicit awaiter(emission_stream& stream)
+                : _stream(stream), _args()
+            { }
+
+            awaiter(const awaiter&) = delete;
+            awaiter& operator = (const awaiter&) = delete;
+
+            bool await_ready()
+            { return _stream.try_pop(_args); }
+
+            bool await_suspend(std::coroutine_handle<> continuation)
+            { return _stream.suspend(continuation, _args); }
+
+            typename result::type await_resume()
+            { return result::get(std::move(*_args)); }
+        };
+
+    private:
+        detail::concurrent_ring_buffer<arguments>   _buffer;
+        stream_overflow                             _overflow;
+        std::shared_ptr<task_executor>              _worker;
+        std::coroutine_handle<>                     _continuation;
+        std::optional<arguments>*                   _pending;
+        std::atomic<bool>                           _waiting;
+        std::atomic<std::size_t>                    _dropped;
+        token                                       _connection;
+
+    public:
+        emission_stream(impl_type& impl, std::size_t capacity, stream_overflow overflow, std::shared_ptr<task_executor> worker)
+            :   _buffer(capacity), _overflow(overflow), _worker(std::move(worker)), _continuation(), _pending(), _waiting(false), _dropped(0),
+                _connection(impl.connect([this](ArgTypes_... args) { this->push(std::forward<ArgTypes_>(args)...); }, handler_attributes::none))
+        { }
+
+        emission_stream(const emission_stream&) = delete;
+        emission_stream& operator = (const emission_stream&) = delete;
+
+        awaiter next()
+        { return awaiter(*this); }
+
+        std::size_t get_dropped_count() const
+        { return _dropped.load(std::memory_order_relaxed); }
+
+    private:
+        // A failed try_push does not touch the arguments, so they may be forwarded again
+        template < typename... Args_ >
+        void push(Args_&&... args)
+        {
+            if (!_buffer.try_push(std::forward<Args_>(args)...))
+            {
+                if (_overflow == stream_overflow::drop_newest)
+                {
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+
+                do
+                {
+                    if (_buffer.try_pop([](arguments&&) { }))
+                        _dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                while (!_buffer.try_push(std::forward<Args_>(args)...));
+            }
+
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!_waiting.load(std::memory_order_relaxed) || !_waiting.exchange(false, std::memory_order_acquire))
+                return;
+
+            if (_worker && !_worker->is_current())
+                _worker->add_task([this] { this->wake(); });
+            else
+                wake();
+        }
+
+        // The consumer may have taken the emission that woke it before it started waiting, then it waits again
+        void wake()
+        {
+            if (*_pending || try_pop(*_pending) || !wait())
+                _continuation.resume();
+        }
+
+        bool try_pop(std::optional<arguments>& args)
+        { return _buffer.try_pop([&](arguments&& a) { args.emplace(std::move(a)); }); }
+
+        bool suspend(std::coroutine_handle<> continuation, std::optional<arguments>& args)
+        {
+            _continuation = continuation;
+            _pending = &args;
+            return wait();
+        }
+
+        // Either the consumer sees the emission that is pushed after it checks the buffer, or the producer sees the consumer
+        // waiting. Returns false if the consumer got an emission and should not wait. If a producer has already taken the
+        // waiting flag, it wakes the consumer anyway
+        bool wait()
+        {
+            _waiting.store(true, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (!try_pop(*_pending))
+                return true;
+
+            return !_waiting.exchange(false, std::memory_order_acq_rel);
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
+
+#endif
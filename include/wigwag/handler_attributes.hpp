@@ -22,7 +22,11 @@ namespace wigwag
     enum class handler_attributes
     {
         none                    = 0x0,
-        suppress_populator      = 0x1
+        suppress_populator      = 0x1,
+
+        // An async handler is invoked in place if the emission happens on its executor. It may then run before the
+        // tasks that the earlier emissions from other threads queued for it
+        inline_if_current       = 0x2
     };
 
     WIGWAG_DECLARE_ENUM_BITWISE_OPERATORS(handler_attributes)
@@ -0,0 +1,110 @@
+#ifndef WIGWAG_HISTOGRAM_SNAPSHOT_HPP
+#define WIGWAG_HISTOGRAM_SNAPSHOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Values are grouped into buckets with 12.5% precision, so the percentiles are approximate
+    class histogram_snapshot
+    {
+    public:
+        static const std::size_t buckets_count = 8 + (64 - 3) * 8;
+
+    private:
+        std::vector<uint64_t>   _buckets;
+        uint64_t                _count;
+        uint64_t                _sum;
+        uint64_t                _max;
+
+    public:
+        histogram_snapshot()
+            : _buckets(buckets_count), _count(0), _sum(0), _max(0)
+        { }
+
+        histogram_snapshot(std::vector<uint64_t> buckets, uint64_t sum, uint64_t max)
+            : _buckets(std::move(buckets)), _count(0), _sum(sum), _max(max)
+        {
+            for (auto b : _buckets)
+                _count += b;
+        }
+
+        uint64_t get_count() const { return _count; }
+        uint64_t get_sum() const { return _sum; }
+        uint64_t get_max() const { return _max; }
+        double get_mean() const { return _count ? (double)_sum / _count : 0.0; }
+
+        uint64_t get_percentile(double p) const
+        {
+            if (_count == 0)
+                return 0;
+
+            uint64_t rank = std::max<uint64_t>(1, (uint64_t)(p * _count + 0.5));
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < _buckets.size(); ++i)
+            {
+                seen += _buckets[i];
+                if (seen >= rank)
+                    return std::min(bucket_upper_bound(i), _max);
+            }
+            return _max;
+        }
+
+        const std::vector<uint64_t>& get_buckets() const { return _buckets; }
+
+        static std::size_t bucket_index(uint64_t value)
+        {
+            if (value < 8)
+                return (std::size_t)value;
+            std::size_t msb = highest_bit(value);
+            return 8 + (msb - 3) * 8 + (std::size_t)((value >> (msb - 3)) & 7);
+        }
+
+        static uint64_t bucket_lower_bound(std::size_t index)
+        {
+            if (index < 8)
+                return index;
+            std::size_t msb = (index - 8) / 8 + 3;
+            return (uint64_t)(8 + (index - 8) % 8) << (msb - 3);
+        }
+
+        static uint64_t bucket_upper_bound(std::size_t index)
+        { return index + 1 < buckets_count ? bucket_lower_bound(index + 1) - 1 : std::numeric_limits<uint64_t>::max(); }
+
+    private:
+        static std::size_t highest_bit(uint64_t value)
+        {
+#if defined(__GNUC__) || defined(__clang)
+            return 63 - __builtin_clzll(value);
+#else
+            std::size_t result = 0;
+            while (value >>= 1)
+                ++result;
+            return result;
+#endif
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
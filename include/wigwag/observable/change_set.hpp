@@ -0,0 +1,61 @@
+#ifndef WIGWAG_OBSERVABLE_CHANGE_SET_HPP
+#define WIGWAG_OBSERVABLE_CHANGE_SET_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <utility>
+#include <vector>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    enum class change_kind
+    {
+        reset,      // the whole state was replaced, e.g. when a new handler is populated with the current state
+        inserted,
+        removed,
+        updated
+    };
+
+
+    // All the changes made by one modification. The changes are listed in the order they were made, the snapshots of the
+    // collection before and after them are shared with the collection and cost nothing to keep
+    template < typename Snapshot_, typename Change_ >
+    class change_set
+    {
+    public:
+        using snapshot_type = Snapshot_;
+        using change_type = Change_;
+
+    private:
+        Snapshot_               _previous;
+        Snapshot_               _current;
+        std::vector<Change_>    _changes;
+
+    public:
+        change_set(Snapshot_ previous, Snapshot_ current, std::vector<Change_> changes)
+            : _previous(std::move(previous)), _current(std::move(current)), _changes(std::move(changes))
+        { }
+
+        const Snapshot_& get_previous() const { return _previous; }
+        const Snapshot_& get_current() const { return _current; }
+        const std::vector<Change_>& get_changes() const { return _changes; }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
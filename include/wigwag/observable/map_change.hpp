@@ -0,0 +1,71 @@
+#ifndef WIGWAG_OBSERVABLE_MAP_CHANGE_HPP
+#define WIGWAG_OBSERVABLE_MAP_CHANGE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/persistent_tree.hpp>
+#include <wigwag/observable/change_set.hpp>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A change of one key. The entries are shared with the snapshots, so no keys or values are copied to describe it. A reset
+    // has no entries, compare the snapshots of the change set instead
+    template < typename Key_, typename Value_, typename Entry_ = std::pair<const Key_, Value_>, typename Projection_ = detail::persistent_tree_identity >
+    class map_change
+    {
+    public:
+        using entry_ptr = typename detail::persistent_tree_node<Entry_>::node_ptr;
+
+    private:
+        change_kind     _kind;
+        entry_ptr       _old_entry;
+        entry_ptr       _new_entry;
+
+    public:
+        map_change(change_kind kind, entry_ptr old_entry, entry_ptr new_entry)
+            : _kind(kind), _old_entry(std::move(old_entry)), _new_entry(std::move(new_entry))
+        { WIGWAG_ASSERT(kind == change_kind::reset || _old_entry || _new_entry, "A map change should have at least one entry!"); }
+
+        change_kind get_kind() const { return _kind; }
+
+        const Key_& get_key() const
+        {
+            WIGWAG_ASSERT(_old_entry || _new_entry, "A reset has no key!");
+            return Projection_::project((_new_entry ? _new_entry : _old_entry)->get_value()).first;
+        }
+
+        bool has_old_value() const { return static_cast<bool>(_old_entry); }
+        bool has_new_value() const { return static_cast<bool>(_new_entry); }
+
+        const Value_& get_old_value() const
+        {
+            WIGWAG_ASSERT(_old_entry, "No old value!");
+            return Projection_::project(_old_entry->get_value()).second;
+        }
+
+        const Value_& get_new_value() const
+        {
+            WIGWAG_ASSERT(_new_entry, "No new value!");
+            return Projection_::project(_new_entry->get_value()).second;
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef WIGWAG_OBSERVABLE_MAP_SNAPSHOT_HPP
+#define WIGWAG_OBSERVABLE_MAP_SNAPSHOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/persistent_tree.hpp>
+
+#include <functional>
+#include <set>
+#include <stdexcept>
+
+
+namespace wigwag {
+namespace detail
+{
+    template < typename Snapshot_, typename Change_, typename... Policies_ >
+    class observable_map_base;
+}
+
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Immutable map ordered by Compare_. Copying is O(1), lookups and the modified copies are O(log n)
+    template < typename Key_, typename Value_, typename Compare_ = std::less<Key_> >
+    class map_snapshot
+    {
+        template < typename, typename, typename... >
+        friend class detail::observable_map_base;
+
+    public:
+        using key_type = Key_;
+        using mapped_type = Value_;
+        using value_type = std::pair<const Key_, Value_>;
+        using size_type = std::size_t;
+        using const_iterator = detail::persistent_tree_iterator<value_type>;
+        using iterator = const_iterator;
+
+    private:
+        using tree = detail::persistent_tree<value_type>;
+        using node_ptr = typename tree::node_ptr;
+
+    private:
+        node_ptr    _root;
+
+    public:
+        map_snapshot() { }
+
+        size_type size() const { return tree::node::get_size(_root); }
+        bool empty() const { return !_root; }
+
+        const_iterator begin() const { return const_iterator(_root.get()); }
+        const_iterator end() const { return const_iterator(); }
+
+        const Value_* find(const Key_& key) const
+        {
+            const node_ptr& n = find_entry(key);
+            return n ? &n->get_value().second : nullptr;
+        }
+
+        bool contains(const Key_& key) const
+        { return static_cast<bool>(find_entry(key)); }
+
+        const Value_& at(const Key_& key) const
+        {
+            const node_ptr& n = find_entry(key);
+            if (!n)
+                WIGWAG_THROW("Key not found!");
+            return n->get_value().second;
+        }
+
+
+        map_snapshot assigned(const Key_& key, Value_ value) const
+        {
+            node_ptr old_entry, new_entry;
+            return assigned(key, std::move(value), old_entry, new_entry);
+        }
+
+        map_snapshot erased(const Key_& key) const
+        {
+            if (!find_entry(key))
+                return *this;
+            return map_snapshot(tree::erase(_root, locator(key)));
+        }
+
+    private:
+        explicit map_snapshot(node_ptr root)
+            : _root(std::move(root))
+        { }
+
+        const node_ptr& find_entry(const Key_& key) const
+        {
+            Compare_ less;
+            const node_ptr* n = &_root;
+            while (*n)
+            {
+                const Key_& k = (*n)->get_value().first;
+                if (less(key, k))
+                    n = &(*n)->get_left();
+                else if (less(k, key))
+                    n = &(*n)->get_right();
+                else
+                    break;
+            }
+            return *n;
+        }
+
+        map_snapshot assigned(const Key_& key, Value_ value, node_ptr& old_entry, node_ptr& new_entry) const
+        {
+            value_type v(key, std::move(value));
+            node_ptr root = tree::replace(_root, locator(key), v, old_entry, new_entry);
+            if (root)
+                return map_snapshot(std::move(root));
+
+            Compare_ less;
+            return map_snapshot(tree::insert(_root, std::move(v), tree::random_priority(), [&](const value_type& v) { return less(v.first, key); }, new_entry));
+        }
+
+        struct key_ptr_less
+        {
+            bool operator()(const Key_* a, const Key_* b) const { return Compare_()(*a, *b); }
+        };
+
+        using key_ptr_set = std::set<const Key_*, key_ptr_less>;
+
+        struct locator
+        {
+            const Key_&     key;
+
+            locator(const Key_& k) : key(k) { }
+
+            int operator()(const node_ptr& n) const
+            {
+                Compare_ less;
+                return less(key, n->get_value().first) ? -1 : (less(n->get_value().first, key) ? 1 : 0);
+            }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
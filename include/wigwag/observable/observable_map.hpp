@@ -0,0 +1,34 @@
+#ifndef WIGWAG_OBSERVABLE_OBSERVABLE_MAP_HPP
+#define WIGWAG_OBSERVABLE_OBSERVABLE_MAP_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/observable_map_base.hpp>
+#include <wigwag/observable/map_change.hpp>
+#include <wigwag/observable/map_snapshot.hpp>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // An ordered map that reports its modifications as change sets of map_change. Snapshots are O(1), see observable_vector
+    template < typename Key_, typename Value_, typename Compare_ = std::less<Key_>, typename... Policies_ >
+    class observable_map : public detail::observable_map_base<map_snapshot<Key_, Value_, Compare_>, map_change<Key_, Value_>, Policies_...>
+    { };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
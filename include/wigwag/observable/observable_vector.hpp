@@ -0,0 +1,194 @@
+#ifndef WIGWAG_OBSERVABLE_OBSERVABLE_VECTOR_HPP
+#define WIGWAG_OBSERVABLE_OBSERVABLE_VECTOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/observable_collection.hpp>
+#include <wigwag/observable/vector_change.hpp>
+#include <wigwag/observable/vector_snapshot.hpp>
+
+#include <initializer_list>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A vector that reports its modifications as change sets. Every modification makes a new snapshot that shares all the
+    // unchanged items with the previous one, so the handlers and get_snapshot() get the state without copying it
+    template < typename T_, typename... Policies_ >
+    class observable_vector : public detail::observable_collection<observable_vector<T_, Policies_...>, vector_snapshot<T_>, vector_change<T_>, Policies_...>
+    {
+        using base = detail::observable_collection<observable_vector<T_, Policies_...>, vector_snapshot<T_>, vector_change<T_>, Policies_...>;
+        using lock_guard = typename base::lock_guard;
+
+        friend base;
+
+    public:
+        using value_type = T_;
+
+    public:
+        observable_vector() { }
+
+        observable_vector(std::initializer_list<T_> items)
+            : base(vector_snapshot<T_>(items.begin(), items.end()))
+        { }
+
+        template < typename It_ >
+        observable_vector(It_ first, It_ last)
+            : base(vector_snapshot<T_>(first, last))
+        { }
+
+        T_ at(std::size_t index) const
+        {
+            lock_guard l(this->sync_root());
+            return this->get_state().at(index);
+        }
+
+        void push_back(T_ value)
+        {
+            lock_guard l(this->sync_root());
+            do_insert(this->get_state().size(), vector_snapshot<T_>(&value, &value + 1));
+        }
+
+        void insert(std::size_t index, T_ value)
+        {
+            lock_guard l(this->sync_root());
+            do_insert(index, vector_snapshot<T_>(&value, &value + 1));
+        }
+
+        template < typename It_ >
+        void insert(std::size_t index, It_ first, It_ last)
+        {
+            vector_snapshot<T_> items(first, last);
+            lock_guard l(this->sync_root());
+            do_insert(index, std::move(items));
+        }
+
+        void erase(std::size_t index, std::size_t count = 1)
+        {
+            lock_guard l(this->sync_root());
+            const vector_snapshot<T_>& state = this->get_state();
+            if (count == 0)
+                return;
+            vector_snapshot<T_> new_state = state.erased(index, count);
+            this->commit(std::move(new_state), std::vector<vector_change<T_>>(1, vector_change<T_>(change_kind::removed, index, state.slice(index, count), vector_snapshot<T_>())));
+        }
+
+        void set(std::size_t index, T_ value)
+        {
+            lock_guard l(this->sync_root());
+            const vector_snapshot<T_>& state = this->get_state();
+            vector_snapshot<T_> new_state = state.replaced(index, std::move(value));
+            this->commit(new_state, std::vector<vector_change<T_>>(1, vector_change<T_>(change_kind::updated, index, state.slice(index, 1), new_state.slice(index, 1))));
+        }
+
+        template < typename It_ >
+        void assign(It_ first, It_ last)
+        { this->reset(vector_snapshot<T_>(first, last)); }
+
+        void clear()
+        {
+            lock_guard l(this->sync_root());
+            erase(0, this->get_state().size());
+        }
+
+    private:
+        void do_insert(std::size_t index, vector_snapshot<T_> items)
+        {
+            if (items.empty())
+                return;
+            vector_snapshot<T_> new_state = this->get_state().inserted(index, items);
+            this->commit(std::move(new_state), std::vector<vector_change<T_>>(1, vector_change<T_>(change_kind::inserted, index, vector_snapshot<T_>(), std::move(items))));
+        }
+
+        static vector_change<T_> make_reset_change(const vector_snapshot<T_>& previous, const vector_snapshot<T_>& current)
+        { return vector_change<T_>(change_kind::reset, 0, previous, current); }
+
+        // Merges each change into the previous one when they touch the same or adjacent ranges, e.g. consecutive
+        // push_backs become one insertion, and an inserted item that is removed later disappears
+        static std::vector<vector_change<T_>> compact_changes(const vector_snapshot<T_>& previous, const vector_snapshot<T_>& current, std::vector<vector_change<T_>> changes)
+        {
+            std::vector<vector_change<T_>> result;
+            for (auto& c : changes)
+            {
+                if (c.get_kind() == change_kind::reset)
+                    return std::vector<vector_change<T_>>(1, make_reset_change(previous, current));
+                if (result.empty() || !merge_change(result, c))
+                    result.push_back(std::move(c));
+            }
+            return result;
+        }
+
+        static bool merge_change(std::vector<vector_change<T_>>& result, const vector_change<T_>& c)
+        {
+            const vector_change<T_>& last = result.back();
+            std::size_t begin = last.get_index();
+            std::size_t end = begin + (last.get_kind() == change_kind::removed ? 0 : last.get_new_items().size());
+            std::size_t index = c.get_index();
+
+            switch (last.get_kind())
+            {
+            case change_kind::inserted:
+            case change_kind::updated:
+                if (c.get_kind() == change_kind::inserted && last.get_kind() == change_kind::inserted && index >= begin && index <= end)
+                {
+                    result.back() = vector_change<T_>(change_kind::inserted, begin, vector_snapshot<T_>(), last.get_new_items().inserted(index - begin, c.get_new_items()));
+                    return true;
+                }
+                if (c.get_kind() == change_kind::removed && last.get_kind() == change_kind::inserted && index >= begin && index + c.get_old_items().size() <= end)
+                {
+                    vector_snapshot<T_> items = last.get_new_items().erased(index - begin, c.get_old_items().size());
+                    if (items.empty())
+                        result.pop_back();
+                    else
+                        result.back() = vector_change<T_>(change_kind::inserted, begin, vector_snapshot<T_>(), std::move(items));
+                    return true;
+                }
+                if (c.get_kind() == change_kind::updated && index >= begin && index + c.get_new_items().size() <= end)
+                {
+                    vector_snapshot<T_> items = last.get_new_items().erased(index - begin, c.get_new_items().size()).inserted(index - begin, c.get_new_items());
+                    result.back() = vector_change<T_>(last.get_kind(), begin, last.get_old_items(), std::move(items));
+                    return true;
+                }
+                if (c.get_kind() == change_kind::updated && last.get_kind() == change_kind::updated && index == end)
+                {
+                    result.back() = vector_change<T_>(change_kind::updated, begin,
+                        last.get_old_items().inserted(last.get_old_items().size(), c.get_old_items()),
+                        last.get_new_items().inserted(last.get_new_items().size(), c.get_new_items()));
+                    return true;
+                }
+                return false;
+            case change_kind::removed:
+                if (c.get_kind() == change_kind::removed && index == begin)
+                {
+                    result.back() = vector_change<T_>(change_kind::removed, begin, last.get_old_items().inserted(last.get_old_items().size(), c.get_old_items()), vector_snapshot<T_>());
+                    return true;
+                }
+                if (c.get_kind() == change_kind::removed && index + c.get_old_items().size() == begin)
+                {
+                    result.back() = vector_change<T_>(change_kind::removed, index, c.get_old_items().inserted(c.get_old_items().size(), last.get_old_items()), vector_snapshot<T_>());
+                    return true;
+                }
+                return false;
+            default:
+                return false;
+            }
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
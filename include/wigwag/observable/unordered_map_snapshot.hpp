@@ -0,0 +1,198 @@
+#ifndef WIGWAG_OBSERVABLE_UNORDERED_MAP_SNAPSHOT_HPP
+#define WIGWAG_OBSERVABLE_UNORDERED_MAP_SNAPSHOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/persistent_tree.hpp>
+
+#include <functional>
+#include <stdexcept>
+#include <unordered_set>
+
+
+namespace wigwag {
+namespace detail
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    template < typename Snapshot_, typename Change_, typename... Policies_ >
+    class observable_map_base;
+
+
+    template < typename Key_, typename Value_ >
+    struct hashed_entry
+    {
+        std::size_t                     hash;
+        std::pair<const Key_, Value_>   entry;
+
+        hashed_entry(std::size_t h, std::pair<const Key_, Value_> e)
+            : hash(h), entry(std::move(e))
+        { }
+
+        struct projection
+        {
+            static const std::pair<const Key_, Value_>& project(const hashed_entry& e) { return e.entry; }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Immutable hash map. The entries are kept in a tree ordered by the hash, so copying is O(1), and lookups and the
+    // modified copies are O(log n) plus the number of colliding keys. Iteration order is unspecified
+    template < typename Key_, typename Value_, typename Hash_ = std::hash<Key_>, typename Equal_ = std::equal_to<Key_> >
+    class unordered_map_snapshot
+    {
+        template < typename, typename, typename... >
+        friend class detail::observable_map_base;
+
+        using entry = detail::hashed_entry<Key_, Value_>;
+        using tree = detail::persistent_tree<entry>;
+        using node_ptr = typename tree::node_ptr;
+
+    public:
+        using key_type = Key_;
+        using mapped_type = Value_;
+        using value_type = std::pair<const Key_, Value_>;
+        using size_type = std::size_t;
+        using const_iterator = detail::persistent_tree_iterator<entry, typename entry::projection>;
+        using iterator = const_iterator;
+
+    private:
+        node_ptr    _root;
+
+    public:
+        unordered_map_snapshot() { }
+
+        size_type size() const { return tree::node::get_size(_root); }
+        bool empty() const { return !_root; }
+
+        const_iterator begin() const { return const_iterator(_root.get()); }
+        const_iterator end() const { return const_iterator(); }
+
+        const Value_* find(const Key_& key) const
+        {
+            const node_ptr& n = find_entry(key);
+            return n ? &n->get_value().entry.second : nullptr;
+        }
+
+        bool contains(const Key_& key) const
+        { return static_cast<bool>(find_entry(key)); }
+
+        const Value_& at(const Key_& key) const
+        {
+            const node_ptr& n = find_entry(key);
+            if (!n)
+                WIGWAG_THROW("Key not found!");
+            return n->get_value().entry.second;
+        }
+
+
+        unordered_map_snapshot assigned(const Key_& key, Value_ value) const
+        {
+            node_ptr old_entry, new_entry;
+            return assigned(key, std::move(value), old_entry, new_entry);
+        }
+
+        unordered_map_snapshot erased(const Key_& key) const
+        {
+            if (!find_entry(key))
+                return *this;
+            return unordered_map_snapshot(tree::erase(_root, locator(key, Hash_()(key))));
+        }
+
+    private:
+        explicit unordered_map_snapshot(node_ptr root)
+            : _root(std::move(root))
+        { }
+
+        const node_ptr& find_entry(const Key_& key) const
+        { return find_node(_root, key, Hash_()(key)); }
+
+        unordered_map_snapshot assigned(const Key_& key, Value_ value, node_ptr& old_entry, node_ptr& new_entry) const
+        {
+            std::size_t hash = Hash_()(key);
+            entry e(hash, value_type(key, std::move(value)));
+            node_ptr root = tree::replace(_root, locator(key, hash), e, old_entry, new_entry);
+            if (root)
+                return unordered_map_snapshot(std::move(root));
+
+            return unordered_map_snapshot(tree::insert(_root, std::move(e), tree::random_priority(), [hash](const entry& e) { return e.hash < hash; }, new_entry));
+        }
+
+        // Equal hashes may end up in both subtrees of a node with the same hash, so these are searched both ways
+        static const node_ptr& find_node(const node_ptr& n, const Key_& key, std::size_t hash)
+        {
+            static const node_ptr null_node;
+            const node_ptr* cur = &n;
+            while (*cur)
+            {
+                const entry& e = (*cur)->get_value();
+                if (hash < e.hash)
+                    cur = &(*cur)->get_left();
+                else if (e.hash < hash)
+                    cur = &(*cur)->get_right();
+                else
+                {
+                    if (Equal_()(key, e.entry.first))
+                        return *cur;
+                    const node_ptr& l = find_node((*cur)->get_left(), key, hash);
+                    return l ? l : find_node((*cur)->get_right(), key, hash);
+                }
+            }
+            return null_node;
+        }
+
+        struct key_ptr_hash
+        {
+            std::size_t operator()(const Key_* k) const { return Hash_()(*k); }
+        };
+
+        struct key_ptr_equal
+        {
+            bool operator()(const Key_* a, const Key_* b) const { return Equal_()(*a, *b); }
+        };
+
+        using key_ptr_set = std::unordered_set<const Key_*, key_ptr_hash, key_ptr_equal>;
+
+        struct locator
+        {
+            const Key_&     key;
+            std::size_t     hash;
+
+            locator(const Key_& k, std::size_t h) : key(k), hash(h) { }
+
+            int operator()(const node_ptr& n) const
+            {
+                const entry& e = n->get_value();
+                if (hash != e.hash)
+                    return hash < e.hash ? -1 : 1;
+                if (Equal_()(key, e.entry.first))
+                    return 0;
+                return find_node(n->get_left(), key, hash) ? -1 : 1;
+            }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef WIGWAG_OBSERVABLE_UPDATE_SCOPE_HPP
+#define WIGWAG_OBSERVABLE_UPDATE_SCOPE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Calls begin_update() and end_update() of an observable collection. The change set is emitted from the destructor,
+    // so the handlers should not throw unless the exception handling policy catches the exceptions
+    template < typename Collection_ >
+    class update_scope
+    {
+    private:
+        Collection_&    _collection;
+
+    public:
+        explicit update_scope(Collection_& collection)
+            : _collection(collection)
+        { _collection.begin_update(); }
+
+        ~update_scope()
+        { _collection.end_update(); }
+
+        update_scope(const update_scope&) = delete;
+        update_scope& operator = (const update_scope&) = delete;
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
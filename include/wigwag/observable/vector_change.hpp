@@ -0,0 +1,54 @@
+#ifndef WIGWAG_OBSERVABLE_VECTOR_CHANGE_HPP
+#define WIGWAG_OBSERVABLE_VECTOR_CHANGE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/observable/change_set.hpp>
+#include <wigwag/observable/vector_snapshot.hpp>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // A range of consecutive items: the inserted ones are in get_new_items(), the removed ones in get_old_items(), and an
+    // update has both. The index refers to the state after the preceding changes of the same change set
+    template < typename T_ >
+    class vector_change
+    {
+    private:
+        change_kind             _kind;
+        std::size_t             _index;
+        vector_snapshot<T_>     _old_items;
+        vector_snapshot<T_>     _new_items;
+
+    public:
+        vector_change(change_kind kind, std::size_t index, vector_snapshot<T_> old_items, vector_snapshot<T_> new_items)
+            : _kind(kind), _index(index), _old_items(std::move(old_items)), _new_items(std::move(new_items))
+        { }
+
+        change_kind get_kind() const { return _kind; }
+        std::size_t get_index() const { return _index; }
+        const vector_snapshot<T_>& get_old_items() const { return _old_items; }
+        const vector_snapshot<T_>& get_new_items() const { return _new_items; }
+    };
+
+
+    template < typename T_ >
+    using vector_change_set = change_set<vector_snapshot<T_>, vector_change<T_>>;
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
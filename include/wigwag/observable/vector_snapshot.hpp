@@ -0,0 +1,126 @@
+#ifndef WIGWAG_OBSERVABLE_VECTOR_SNAPSHOT_HPP
+#define WIGWAG_OBSERVABLE_VECTOR_SNAPSHOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/persistent_tree.hpp>
+
+#include <iterator>
+#include <stdexcept>
+
+
+namespace wigwag {
+namespace observable
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Immutable sequence. Copying is O(1), element access and the modified copies are O(log n)
+    template < typename T_ >
+    class vector_snapshot
+    {
+        using tree = detail::persistent_tree<T_>;
+        using node_ptr = typename tree::node_ptr;
+
+    public:
+        using value_type = T_;
+        using size_type = std::size_t;
+        using const_reference = const T_&;
+        using const_iterator = detail::persistent_tree_iterator<T_>;
+        using iterator = const_iterator;
+
+    private:
+        node_ptr    _root;
+
+    public:
+        vector_snapshot() { }
+
+        template < typename It_ >
+        vector_snapshot(It_ first, It_ last)
+            : _root(tree::build(first, std::distance(first, last)))
+        { }
+
+        size_type size() const { return tree::node::get_size(_root); }
+        bool empty() const { return !_root; }
+
+        const_reference operator[](size_type index) const
+        {
+            WIGWAG_ASSERT(index < size(), "Index out of range!");
+            return tree::at(_root, index)->get_value();
+        }
+
+        const_reference at(size_type index) const
+        {
+            if (index >= size())
+                WIGWAG_THROW("Index out of range!");
+            return tree::at(_root, index)->get_value();
+        }
+
+        const_reference front() const { return (*this)[0]; }
+        const_reference back() const { return (*this)[size() - 1]; }
+
+        const_iterator begin() const { return const_iterator(_root.get()); }
+        const_iterator end() const { return const_iterator(); }
+
+
+        vector_snapshot slice(size_type index, size_type count) const
+        {
+            check_range(index, count);
+            if (count == 1)
+                return vector_snapshot(tree::make_node(tree::at(_root, index)->get_value()));
+            return vector_snapshot(tree::split_at(tree::split_at(_root, index).second, count).first);
+        }
+
+        vector_snapshot inserted(size_type index, T_ value) const
+        {
+            check_range(index, 0);
+            auto p = tree::split_at(_root, index);
+            return vector_snapshot(tree::merge(tree::merge(p.first, tree::make_node(std::move(value))), p.second));
+        }
+
+        vector_snapshot inserted(size_type index, const vector_snapshot& items) const
+        {
+            check_range(index, 0);
+            auto p = tree::split_at(_root, index);
+            return vector_snapshot(tree::merge(tree::merge(p.first, items._root), p.second));
+        }
+
+        vector_snapshot erased(size_type index, size_type count = 1) const
+        {
+            check_range(index, count);
+            auto p = tree::split_at(_root, index);
+            return vector_snapshot(tree::merge(p.first, tree::split_at(p.second, count).second));
+        }
+
+        vector_snapshot replaced(size_type index, T_ value) const
+        {
+            check_range(index, 1);
+            return vector_snapshot(tree::replace_at(_root, index, std::move(value)));
+        }
+
+    private:
+        explicit vector_snapshot(node_ptr root)
+            : _root(std::move(root))
+        { }
+
+        void check_range(size_type index, size_type count) const
+        {
+            if (index > size() || count > size() - index)
+                WIGWAG_THROW("Index out of range!");
+        }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
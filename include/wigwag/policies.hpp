@@ -13,9 +13,12 @@
 
 #include <wigwag/policies/creation/policies.hpp>
 #include <wigwag/policies/exception_handling/policies.hpp>
+#include <wigwag/policies/instrumentation/policies.hpp>
 #include <wigwag/policies/life_assurance/policies.hpp>
+#include <wigwag/policies/profiling/policies.hpp>
 #include <wigwag/policies/ref_counter/policies.hpp>
 #include <wigwag/policies/state_populating/policies.hpp>
+#include <wigwag/policies/task_queue/policies.hpp>
 #include <wigwag/policies/threading/policies.hpp>
 
 #endif
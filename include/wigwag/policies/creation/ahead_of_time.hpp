@@ -40,6 +40,9 @@ namespace creation
             const OwningPtr_& get_ptr() const
             { return _ptr; }
 
+            decltype(std::declval<const OwningPtr_&>().get()) get() const
+            { return _ptr.get(); }
+
             bool constructed() const
             { return (bool)_ptr; }
         };
@@ -0,0 +1,108 @@
+#ifndef WIGWAG_POLICIES_CREATION_EMBEDDED_HPP
+#define WIGWAG_POLICIES_CREATION_EMBEDDED_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/detail/storage_for.hpp>
+#include <wigwag/policies/creation/tag.hpp>
+
+#include <type_traits>
+#include <utility>
+
+
+namespace wigwag {
+namespace creation
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct embedded
+    {
+        using tag = creation::tag<api_version<2, 0>>;
+
+        // The implementation object lives inside the storage until something needs an owning pointer to it (e.g. signal_connector).
+        // Handler nodes that outlive the storage are moved to a heap-allocated orphan implementation.
+        // If the nodes are moved by a handler, the emission that called it keeps running on the embedded object, so it is destroyed later.
+        template < typename OwningPtr_, typename DefaultType_ >
+        class storage
+        {
+            static_assert(DefaultType_::relocatable, "creation::embedded requires threading::none and either life_assurance::none or life_assurance::single_threaded!");
+
+            using embedded_storage = wigwag::detail::storage_for<DefaultType_>;
+
+        private:
+            mutable embedded_storage    _embedded_obj;
+            mutable bool                _embedded;
+            mutable bool                _destruct_pending;
+            mutable OwningPtr_          _ptr;
+
+        public:
+            storage()
+                : _embedded_obj(typename embedded_storage::no_construct_tag()), _embedded(false), _destruct_pending(false)
+            { }
+
+            ~storage()
+            {
+                if (_destruct_pending)
+                    _embedded_obj.destruct();
+
+                if (!_embedded)
+                    return;
+
+                if (_embedded_obj.ref().has_nodes())
+                    _ptr.reset(_embedded_obj.ref().relocate());
+                _embedded_obj.destruct();
+            }
+
+            storage(const storage&) = delete;
+            storage& operator = (const storage&) = delete;
+
+            template < typename T_, typename... Args_ >
+            typename std::enable_if<std::is_same<T_, DefaultType_>::value>::type create(Args_&&... args)
+            {
+                _embedded_obj.construct(std::forward<Args_>(args)...);
+                _embedded = true;
+            }
+
+            template < typename T_, typename... Args_ >
+            typename std::enable_if<!std::is_same<T_, DefaultType_>::value>::type create(Args_&&... args)
+            { _ptr.reset(new T_(std::forward<Args_>(args)...)); }
+
+            const OwningPtr_& get_ptr() const
+            {
+                if (_embedded)
+                {
+                    _ptr.reset(_embedded_obj.ref().relocate());
+                    _embedded = false;
+                    _destruct_pending = true;
+                }
+                if (_destruct_pending && !_embedded_obj.ref().is_emitting())
+                {
+                    _embedded_obj.destruct();
+                    _destruct_pending = false;
+                }
+                return _ptr;
+            }
+
+            decltype(std::declval<const OwningPtr_&>().get()) get() const
+            { return _embedded ? &_embedded_obj.ref() : _ptr.get(); }
+
+            bool constructed() const
+            { return _embedded || (bool)_ptr; }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
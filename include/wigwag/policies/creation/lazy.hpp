@@ -48,6 +48,12 @@ namespace creation
                 return _ptr;
             }
 
+            decltype(std::declval<const OwningPtr_&>().get()) get() const
+            {
+                ensure_created();
+                return _ptr.get();
+            }
+
             bool constructed() const
             { return (bool)_ptr; }
 
@@ -12,6 +12,7 @@
 
 
 #include <wigwag/policies/creation/ahead_of_time.hpp>
+#include <wigwag/policies/creation/embedded.hpp>
 #include <wigwag/policies/creation/lazy.hpp>
 
 
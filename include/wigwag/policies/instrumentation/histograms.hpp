@@ -0,0 +1,105 @@
+#ifndef WIGWAG_POLICIES_INSTRUMENTATION_HISTOGRAMS_HPP
+#define WIGWAG_POLICIES_INSTRUMENTATION_HISTOGRAMS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/histogram.hpp>
+#include <wigwag/policies/instrumentation/tag.hpp>
+#include <wigwag/task_executor_statistics.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+
+namespace wigwag {
+namespace instrumentation
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Records the time tasks spend in the queue and run time. Every task is wrapped into a functor that keeps its enqueue time
+    struct histograms
+    {
+        using tag = instrumentation::tag<api_version<2, 0>>;
+
+        class recorder
+        {
+            using clock = std::chrono::steady_clock;
+
+            class instrumented_task
+            {
+            private:
+                recorder*                   _recorder;
+                clock::time_point           _queued;
+                std::function<void()>       _task;
+
+            public:
+                instrumented_task(recorder* r, std::function<void()>&& task)
+                    : _recorder(r), _queued(clock::now()), _task(std::move(task))
+                { }
+
+                void operator() () const
+                {
+                    clock::time_point started = clock::now();
+                    _recorder->_wait_time.record(to_ns(started - _queued));
+                    auto sg = detail::at_scope_exit([&] { _recorder->task_finished(started); } );
+                    _task();
+                }
+            };
+
+        private:
+            detail::histogram           _wait_time;
+            detail::histogram           _run_time;
+            std::atomic<std::size_t>    _max_queue_depth;
+            std::atomic<uint64_t>       _tasks_completed;
+            clock::time_point           _created;
+
+        public:
+            recorder()
+                : _max_queue_depth(0), _tasks_completed(0), _created(clock::now())
+            { }
+
+            std::function<void()> wrap_task(std::function<void()>&& task)
+            { return instrumented_task(this, std::move(task)); }
+
+            void task_queued(std::size_t queue_depth)
+            {
+                std::size_t max = _max_queue_depth.load(std::memory_order_relaxed);
+                while (queue_depth > max && !_max_queue_depth.compare_exchange_weak(max, queue_depth, std::memory_order_relaxed))
+                    ;
+            }
+
+            task_executor_statistics get_statistics() const
+            {
+                uint64_t completed = _tasks_completed.load(std::memory_order_relaxed);
+                double seconds = std::chrono::duration<double>(clock::now() - _created).count();
+                return task_executor_statistics(_wait_time.get_snapshot(), _run_time.get_snapshot(), _max_queue_depth.load(std::memory_order_relaxed), completed, seconds > 0 ? completed / seconds : 0.0);
+            }
+
+        private:
+            void task_finished(clock::time_point started)
+            {
+                _run_time.record(to_ns(clock::now() - started));
+                _tasks_completed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            static uint64_t to_ns(clock::duration d)
+            { return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(); }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef WIGWAG_POLICIES_INSTRUMENTATION_NONE_HPP
+#define WIGWAG_POLICIES_INSTRUMENTATION_NONE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/policies/instrumentation/tag.hpp>
+
+#include <functional>
+
+
+namespace wigwag {
+namespace instrumentation
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct none
+    {
+        using tag = instrumentation::tag<api_version<2, 0>>;
+
+        class recorder
+        {
+        public:
+            std::function<void()> wrap_task(std::function<void()>&& task)
+            { return std::move(task); }
+
+            void task_queued(std::size_t) { }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef WIGWAG_POLICIES_PROFILING_NONE_HPP
+#define WIGWAG_POLICIES_PROFILING_NONE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/policies/profiling/tag.hpp>
+
+
+namespace wigwag {
+namespace profiling
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct none
+    {
+        using tag = profiling::tag<api_version<2, 0>>;
+
+        template < typename Signature_ >
+        class profiler
+        {
+        public:
+            struct handler_data
+            { };
+
+            class emission
+            {
+            public:
+                emission(profiler&) { }
+                ~emission() { }
+            };
+
+            class handler_scope
+            {
+            public:
+                handler_scope(emission&, handler_data&) { }
+                ~handler_scope() { }
+            };
+
+            void handler_added(handler_data&) { }
+            void handler_moved(handler_data&, profiler&) { }
+            void handler_removed(handler_data&) { }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
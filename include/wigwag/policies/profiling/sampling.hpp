@@ -0,0 +1,119 @@
+#ifndef WIGWAG_POLICIES_PROFILING_SAMPLING_HPP
+#define WIGWAG_POLICIES_PROFILING_SAMPLING_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/signal_profile.hpp>
+#include <wigwag/detail/tsc.hpp>
+#include <wigwag/detail/type_name.hpp>
+#include <wigwag/policies/profiling/tag.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace wigwag {
+namespace profiling
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Counts every emission, but reads the timestamps only for one emission out of Period_
+    template < std::size_t Period_ >
+    struct basic_sampling
+    {
+        static_assert(Period_ > 0 && (Period_ & (Period_ - 1)) == 0, "The sampling period should be a power of two!");
+
+        using tag = profiling::tag<api_version<2, 0>>;
+
+        template < typename Signature_ >
+        class profiler
+        {
+        public:
+            using handler_data = detail::handler_profile;
+
+            class handler_scope;
+
+            class emission
+            {
+                friend class handler_scope;
+
+            private:
+                profiler&       _profiler;
+                bool            _sampled;
+                uint64_t        _start;
+                std::size_t     _handlers_count;
+
+            public:
+                emission(profiler& p)
+                    : _profiler(p), _sampled((p._signal_profile.count_emission() & (Period_ - 1)) == 0), _start(_sampled ? detail::tsc::now() : 0), _handlers_count(0)
+                { }
+
+                ~emission()
+                {
+                    if (_sampled)
+                        _profiler._signal_profile.emission_sampled(detail::tsc::now() - _start, _handlers_count);
+                }
+
+                emission(const emission&) = delete;
+                emission& operator = (const emission&) = delete;
+            };
+
+            class handler_scope
+            {
+            private:
+                emission&       _emission;
+                handler_data&   _data;
+                uint64_t        _start;
+
+            public:
+                handler_scope(emission& e, handler_data& data)
+                    : _emission(e), _data(data), _start(e._sampled ? detail::tsc::now() : 0)
+                { }
+
+                ~handler_scope()
+                {
+                    if (!_emission._sampled)
+                        return;
+                    ++_emission._handlers_count;
+                    _data.record(detail::tsc::now() - _start);
+                }
+
+                handler_scope(const handler_scope&) = delete;
+                handler_scope& operator = (const handler_scope&) = delete;
+            };
+
+        private:
+            detail::signal_profile      _signal_profile;
+
+        public:
+            profiler()
+                : _signal_profile(detail::get_type_name<Signature_>())
+            { }
+
+            void handler_added(handler_data& h)
+            { _signal_profile.handler_added(h); }
+
+            void handler_moved(handler_data& h, profiler& from)
+            { _signal_profile.handler_moved(h, from._signal_profile); }
+
+            void handler_removed(handler_data& h)
+            { _signal_profile.handler_removed(h); }
+        };
+    };
+
+    using sampling = basic_sampling<16>;
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
@@ -13,6 +13,7 @@
 #include <wigwag/policies/state_populating/none.hpp>
 #include <wigwag/policies/state_populating/populator_and_withdrawer.hpp>
 #include <wigwag/policies/state_populating/populator_only.hpp>
+#include <wigwag/policies/state_populating/snapshot_populator.hpp>
 
 namespace wigwag {
 namespace state_populating
@@ -0,0 +1,63 @@
+#ifndef WIGWAG_POLICIES_STATE_POPULATING_SNAPSHOT_POPULATOR_HPP
+#define WIGWAG_POLICIES_STATE_POPULATING_SNAPSHOT_POPULATOR_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+#include <wigwag/policies/state_populating/tag.hpp>
+
+#include <functional>
+
+
+namespace wigwag {
+namespace state_populating
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // The function passed to the signal is called under the lock and should only take a snapshot of the state (e.g. copy
+    // a pointer to immutable data) and return a populator bound to it. Signals call that populator outside the lock, and
+    // the events emitted meanwhile are delivered to the new handler after it. Asynchronous handlers get the whole
+    // snapshot in a single task on their executor, queued before the subsequent events. Listenables call it under the lock
+    struct snapshot_populator
+    {
+        using tag = state_populating::tag<api_version<2, 0>>;
+
+        template < typename HandlerType_ >
+        class handler_processor
+        {
+        WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
+            using populator_func = std::function<void(const HandlerType_&)>;
+            using snapshot_func = std::function<populator_func()>;
+
+        private:
+            snapshot_func       _take_snapshot;
+
+        public:
+            handler_processor(snapshot_func take_snapshot = snapshot_func())
+                : _take_snapshot(take_snapshot)
+            { }
+
+            populator_func take_snapshot() const { return _take_snapshot(); }
+
+            bool has_populate_state() const WIGWAG_NOEXCEPT { return (bool)_take_snapshot; }
+            void populate_state(const HandlerType_& handler) const { _take_snapshot()(handler); }
+
+            bool has_withdraw_state() const WIGWAG_NOEXCEPT { return false; }
+            void withdraw_state(const HandlerType_&) const WIGWAG_NOEXCEPT { }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
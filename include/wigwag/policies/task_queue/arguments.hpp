@@ -0,0 +1,54 @@
+#ifndef WIGWAG_POLICIES_TASK_QUEUE_ARGUMENTS_HPP
+#define WIGWAG_POLICIES_TASK_QUEUE_ARGUMENTS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace wigwag {
+namespace task_queue
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Keeps the arguments of a task queue apart from the ones of the exception handling policy when both are passed to an executor:
+    // basic_thread_task_executor<task_queue::coalesce>(task_queue::args(256, merge), exception_handler)
+    template < typename... Args_ >
+    struct arguments
+    {
+        std::tuple<Args_...>    values;
+
+        explicit arguments(std::tuple<Args_...> v)
+            : values(std::move(v))
+        { }
+    };
+
+    template < typename... Args_ >
+    arguments<typename std::decay<Args_>::type...> args(Args_&&... a)
+    { return arguments<typename std::decay<Args_>::type...>(std::make_tuple(std::forward<Args_>(a)...)); }
+
+
+    template < typename T_ >
+    struct is_arguments
+    { static const bool value = false; };
+
+    template < typename... Args_ >
+    struct is_arguments<arguments<Args_...>>
+    { static const bool value = true; };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
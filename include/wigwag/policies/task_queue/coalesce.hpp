@@ -0,0 +1,80 @@
+#ifndef WIGWAG_POLICIES_TASK_QUEUE_COALESCE_HPP
+#define WIGWAG_POLICIES_TASK_QUEUE_COALESCE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/ring_buffer.hpp>
+#include <wigwag/policies/task_queue/tag.hpp>
+#include <wigwag/task_queue_statistics.hpp>
+
+#include <functional>
+
+
+namespace wigwag {
+namespace task_queue
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // When the queue is full, the newest queued task is merged with the incoming one. By default the incoming task simply replaces it
+    struct coalesce
+    {
+        using tag = task_queue::tag<api_version<2, 0>>;
+
+        class queue
+        {
+            using task = std::function<void()>;
+
+        public:
+            using coalesce_func = std::function<task(task queued, task incoming)>;
+
+        private:
+            detail::ring_buffer<task>   _tasks;
+            coalesce_func               _coalesce_func;
+            std::size_t                 _coalesced;
+
+        public:
+            explicit queue(std::size_t capacity, coalesce_func f = &queue::replace)
+                : _tasks(capacity), _coalesce_func(std::move(f)), _coalesced(0)
+            { }
+
+            bool empty() const { return _tasks.empty(); }
+            std::size_t size() const { return _tasks.size(); }
+
+            template < typename Lock_ >
+            void push(task&& t, Lock_&, bool)
+            {
+                if (_tasks.full())
+                {
+                    _tasks.back() = _coalesce_func(std::move(_tasks.back()), std::move(t));
+                    ++_coalesced;
+                }
+                else
+                    _tasks.push_back(std::move(t));
+            }
+
+            task pop()
+            { return _tasks.pop_front(); }
+
+            task_queue_statistics get_statistics() const
+            { return task_queue_statistics(0, _coalesced); }
+
+        private:
+            static task replace(task, task incoming)
+            { return incoming; }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
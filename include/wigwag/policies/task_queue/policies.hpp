@@ -0,0 +1,29 @@
+#ifndef WIGWAG_POLICIES_TASK_QUEUE_POLICIES_HPP
+#define WIGWAG_POLICIES_TASK_QUEUE_POLICIES_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/policies/task_queue/arguments.hpp>
+#include <wigwag/policies/task_queue/block_producer.hpp>
+#include <wigwag/policies/task_queue/coalesce.hpp>
+#include <wigwag/policies/task_queue/drop_newest.hpp>
+#include <wigwag/policies/task_queue/drop_oldest.hpp>
+#include <wigwag/policies/task_queue/unbounded.hpp>
+
+namespace wigwag {
+namespace task_queue
+{
+
+    using default_ = unbounded;
+
+}}
+
+#endif
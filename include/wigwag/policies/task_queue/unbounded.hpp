@@ -0,0 +1,64 @@
+#ifndef WIGWAG_POLICIES_TASK_QUEUE_UNBOUNDED_HPP
+#define WIGWAG_POLICIES_TASK_QUEUE_UNBOUNDED_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/policies/task_queue/tag.hpp>
+#include <wigwag/task_queue_statistics.hpp>
+
+#include <functional>
+#include <queue>
+#include <utility>
+
+
+namespace wigwag {
+namespace task_queue
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    struct unbounded
+    {
+        using tag = task_queue::tag<api_version<2, 0>>;
+
+        class queue
+        {
+            using task = std::function<void()>;
+
+        private:
+            std::queue<task>    _tasks;
+
+        public:
+            bool empty() const { return _tasks.empty(); }
+            std::size_t size() const { return _tasks.size(); }
+
+            template < typename Lock_ >
+            void push(task&& t, Lock_&, bool)
+            { _tasks.push(std::move(t)); }
+
+            task pop()
+            {
+                task result;
+                std::swap(_tasks.front(), result);
+                _tasks.pop();
+                return result;
+            }
+
+            task_queue_statistics get_statistics() const
+            { return task_queue_statistics(); }
+        };
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
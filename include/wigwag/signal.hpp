@@ -15,6 +15,8 @@
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
 #include <wigwag/detail/signal_impl.hpp>
+#include <wigwag/emission_awaiter.hpp>
+#include <wigwag/emission_stream.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/signal_connector.hpp>
 
@@ -32,7 +34,8 @@ namespace wigwag
                 policies_config_entry<state_populating::policy_concept, wigwag::state_populating::default_>,
                 policies_config_entry<life_assurance::policy_concept, wigwag::life_assurance::default_>,
                 policies_config_entry<creation::policy_concept, wigwag::creation::default_>,
-                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>
+                policies_config_entry<ref_counter::policy_concept, wigwag::ref_counter::default_>,
+                policies_config_entry<profiling::policy_concept, wigwag::profiling::default_>
             >;
 
         template < typename T_ >
@@ -66,13 +69,14 @@ namespace wigwag
         using life_assurance_policy = policy<detail::life_assurance::policy_concept>;
         using creation_policy = policy<detail::creation::policy_concept>;
         using ref_counter_policy = policy<detail::ref_counter::policy_concept>;
+        using profiling_policy = policy<detail::profiling::policy_concept>;
 
     public:
         using handler_type = std::function<signature>;
 
     WIGWAG_PRIVATE_IS_CONSTRUCTIBLE_WORKAROUND:
-        using impl_type = detail::signal_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy>;
-        using impl_type_with_attr = detail::signal_with_attributes_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy>;
+        using impl_type = detail::signal_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy, profiling_policy>;
+        using impl_type_with_attr = detail::signal_with_attributes_impl<signature, exception_handling_policy, threading_policy, state_populating_policy, life_assurance_policy, ref_counter_policy, profiling_policy>;
 
     private:
         using impl_type_ptr = detail::intrusive_ptr<impl_type>;
@@ -124,11 +128,28 @@ namespace wigwag
         token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
         { return _impl->connect(std::move(worker), std::move(handler), attributes); }
 
+#if WIGWAG_HAS_COROUTINES
+        // co_await s.next() waits for the next emission, see emission_awaiter
+        emission_awaiter<signature> next(std::shared_ptr<task_executor> worker = nullptr) const
+        { return emission_awaiter<signature>(_impl.get_ptr(), std::move(worker)); }
+
+        // for (;;) { auto ev = co_await stream.next(); ... } consumes the emissions through a bounded buffer, see emission_stream
+        emission_stream<signature> stream(std::size_t capacity, stream_overflow overflow = stream_overflow::drop_newest, std::shared_ptr<task_executor> worker = nullptr) const
+        { return emission_stream<signature>(*_impl.get_ptr(), capacity, overflow, std::move(worker)); }
+#endif
+
         void operator() (ArgTypes_... args) const
         {
             if (_impl)
                 _impl->invoke(args...);
         }
+
+        // Same as operator(), but moves the arguments into the last handler instead of copying them
+        void emit_move(ArgTypes_... args) const
+        {
+            if (_impl)
+                _impl->invoke_move(std::forward<ArgTypes_>(args)...);
+        }
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
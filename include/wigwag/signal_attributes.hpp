@@ -23,7 +23,8 @@ namespace wigwag
     {
         none                = 0x0,
         connect_sync_only   = 0x1,
-        connect_async_only  = 0x2
+        connect_async_only  = 0x2,
+        queued_emission     = 0x4
     };
 
     WIGWAG_DECLARE_ENUM_BITWISE_OPERATORS(signal_attributes)
@@ -13,6 +13,8 @@
 
 #include <wigwag/detail/intrusive_ptr.hpp>
 #include <wigwag/detail/signal_connector_impl.hpp>
+#include <wigwag/emission_awaiter.hpp>
+#include <wigwag/emission_stream.hpp>
 #include <wigwag/handler_attributes.hpp>
 
 
@@ -46,6 +48,14 @@ namespace wigwag
         template < typename HandlerFunc_ >
         token connect(std::shared_ptr<task_executor> worker, HandlerFunc_ handler, handler_attributes attributes = handler_attributes::none) const
         { return _impl->connect(std::move(worker), std::move(handler), attributes); }
+
+#if WIGWAG_HAS_COROUTINES
+        emission_awaiter<Signature_> next(std::shared_ptr<task_executor> worker = nullptr) const
+        { return emission_awaiter<Signature_>(_impl, std::move(worker)); }
+
+        emission_stream<Signature_> stream(std::size_t capacity, stream_overflow overflow = stream_overflow::drop_newest, std::shared_ptr<task_executor> worker = nullptr) const
+        { return emission_stream<Signature_>(*_impl, capacity, overflow, std::move(worker)); }
+#endif
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
@@ -0,0 +1,65 @@
+#ifndef WIGWAG_SIGNAL_PROFILING_HPP
+#define WIGWAG_SIGNAL_PROFILING_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/signal_profile.hpp>
+#include <wigwag/signal_profiling_snapshot.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Returns the profiles of all the existing signals that use the profiling::sampling policy, the hottest ones go first
+    inline std::vector<signal_profiling_snapshot> get_signal_profiling_snapshots()
+    {
+        std::vector<signal_profiling_snapshot> result = detail::signal_profile_registry::instance().get_snapshots();
+        std::sort(result.begin(), result.end(),
+            [](const signal_profiling_snapshot& l, const signal_profiling_snapshot& r) { return l.get_estimated_total_ns() > r.get_estimated_total_ns(); });
+        return result;
+    }
+
+
+    inline void print_signal_profiling_report(std::ostream& os, std::size_t top_n = 10, std::size_t top_handlers = 3)
+    {
+        std::vector<signal_profiling_snapshot> profiles = get_signal_profiling_snapshots();
+        if (profiles.size() > top_n)
+            profiles.erase(profiles.begin() + top_n, profiles.end());
+
+        for (std::size_t i = 0; i < profiles.size(); ++i)
+        {
+            const signal_profiling_snapshot& p = profiles[i];
+            os << "#" << (i + 1) << " signal<" << p.get_signature() << "> at " << p.get_address()
+                << ": emits: " << p.get_emit_count()
+                << ", sampled: " << p.get_sampled_count()
+                << ", handlers: " << p.get_handlers_count()
+                << ", mean: " << p.get_mean_invoke_ns() << " ns"
+                << ", p99: " << p.get_invoke_ns_percentile(0.99) << " ns"
+                << ", estimated total: " << p.get_estimated_total_ns() << " ns" << std::endl;
+
+            const auto& handlers = p.get_handlers();
+            for (std::size_t j = 0; j < handlers.size() && j < top_handlers; ++j)
+                os << "    handler #" << handlers[j].get_id() << ": calls: " << handlers[j].get_calls() << ", total: " << handlers[j].get_total_ns() << " ns" << std::endl;
+        }
+    }
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef WIGWAG_SIGNAL_PROFILING_SNAPSHOT_HPP
+#define WIGWAG_SIGNAL_PROFILING_SNAPSHOT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/histogram_snapshot.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // The handlers that are already disconnected are reported too, and are told apart by their ids
+    class handler_profiling_snapshot
+    {
+    private:
+        uint64_t        _id;
+        uint64_t        _calls;
+        double          _total_ns;
+
+    public:
+        handler_profiling_snapshot(uint64_t id, uint64_t calls, double total_ns)
+            : _id(id), _calls(calls), _total_ns(total_ns)
+        { }
+
+        uint64_t get_id() const { return _id; }
+        uint64_t get_calls() const { return _calls; }
+        double get_total_ns() const { return _total_ns; }
+    };
+
+
+    // Only the sampled emissions are timed, so the timings describe a subset of get_emit_count() emissions
+    class signal_profiling_snapshot
+    {
+    private:
+        std::string                                 _signature;
+        const void*                                 _address;
+        uint64_t                                    _emit_count;
+        histogram_snapshot                          _invoke_ticks;
+        double                                      _ns_per_tick;
+        std::size_t                                 _handlers_count;
+        std::vector<handler_profiling_snapshot>     _handlers;
+
+    public:
+        signal_profiling_snapshot(std::string signature, const void* address, uint64_t emit_count, histogram_snapshot invoke_ticks, double ns_per_tick, std::size_t handlers_count, std::vector<handler_profiling_snapshot> handlers)
+            :   _signature(std::move(signature)), _address(address), _emit_count(emit_count), _invoke_ticks(std::move(invoke_ticks)),
+                _ns_per_tick(ns_per_tick), _handlers_count(handlers_count), _handlers(std::move(handlers))
+        { }
+
+        const std::string& get_signature() const { return _signature; }
+        const void* get_address() const { return _address; }
+        uint64_t get_emit_count() const { return _emit_count; }
+        uint64_t get_sampled_count() const { return _invoke_ticks.get_count(); }
+        std::size_t get_handlers_count() const { return _handlers_count; }
+
+        // Sorted by the total time, the slowest handler goes first
+        const std::vector<handler_profiling_snapshot>& get_handlers() const { return _handlers; }
+
+        double get_mean_invoke_ns() const { return _invoke_ticks.get_mean() * _ns_per_tick; }
+        double get_invoke_ns_percentile(double p) const { return _invoke_ticks.get_percentile(p) * _ns_per_tick; }
+
+        double get_estimated_total_ns() const
+        { return get_sampled_count() ? _invoke_ticks.get_sum() * _ns_per_tick * _emit_count / get_sampled_count() : 0.0; }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -11,6 +11,7 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <chrono>
 #include <functional>
 
 
@@ -24,6 +25,19 @@ namespace wigwag
         virtual ~task_executor() { }
 
         virtual void add_task(std::function<void()> task) = 0;
+
+        // Returns true if called on the thread that executes the tasks, so running a task inline would not change the
+        // thread it is executed on. Executors that can not tell return false
+        virtual bool is_current() const { return false; }
+    };
+
+
+    // An executor that may also postpone a task until the specified moment
+    struct timed_task_executor : public task_executor
+    {
+        using clock = std::chrono::steady_clock;
+
+        virtual void add_task_at(clock::time_point deadline, std::function<void()> task) = 0;
     };
 
 #include <wigwag/detail/enable_warnings.hpp>
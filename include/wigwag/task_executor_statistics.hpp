@@ -0,0 +1,51 @@
+#ifndef WIGWAG_TASK_EXECUTOR_STATISTICS_HPP
+#define WIGWAG_TASK_EXECUTOR_STATISTICS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/histogram_snapshot.hpp>
+
+#include <cstdint>
+#include <utility>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Times are measured in nanoseconds
+    class task_executor_statistics
+    {
+    private:
+        histogram_snapshot      _wait_time;
+        histogram_snapshot      _run_time;
+        std::size_t             _max_queue_depth;
+        uint64_t                _tasks_completed;
+        double                  _tasks_per_second;
+
+    public:
+        task_executor_statistics(histogram_snapshot wait_time, histogram_snapshot run_time, std::size_t max_queue_depth, uint64_t tasks_completed, double tasks_per_second)
+            : _wait_time(std::move(wait_time)), _run_time(std::move(run_time)), _max_queue_depth(max_queue_depth), _tasks_completed(tasks_completed), _tasks_per_second(tasks_per_second)
+        { }
+
+        const histogram_snapshot& get_wait_time() const { return _wait_time; }
+        const histogram_snapshot& get_run_time() const { return _run_time; }
+        std::size_t get_max_queue_depth() const { return _max_queue_depth; }
+        uint64_t get_tasks_completed() const { return _tasks_completed; }
+        double get_tasks_per_second() const { return _tasks_per_second; }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef WIGWAG_TASK_QUEUE_STATISTICS_HPP
+#define WIGWAG_TASK_QUEUE_STATISTICS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <cstddef>
+
+
+namespace wigwag
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    class task_queue_statistics
+    {
+    private:
+        std::size_t     _dropped;
+        std::size_t     _coalesced;
+
+    public:
+        task_queue_statistics(std::size_t dropped = 0, std::size_t coalesced = 0)
+            : _dropped(dropped), _coalesced(coalesced)
+        { }
+
+        std::size_t get_dropped_count() const { return _dropped; }
+        std::size_t get_coalesced_count() const { return _coalesced; }
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}
+
+#endif
@@ -11,13 +11,22 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/index_sequence.hpp>
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/detail/probes.hpp>
+#include <wigwag/detail/tracing.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/task_executor.hpp>
+#include <wigwag/task_queue_statistics.hpp>
 
-#include <queue>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace wigwag
@@ -28,32 +37,62 @@ namespace wigwag
     namespace detail
     {
         using thread_task_executor_policies_config = policies_config<
-                policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>
+                policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>,
+                policies_config_entry<task_queue::policy_concept, wigwag::task_queue::default_>,
+                policies_config_entry<instrumentation::policy_concept, wigwag::instrumentation::default_>
             >;
     }
 
 
     template < typename... Policies_ >
     class basic_thread_task_executor :
-        public task_executor,
+        public timed_task_executor,
         private detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_task_executor_policies_config, Policies_...>::type
     {
-        using exception_handling_policy = typename detail::policy_picker<detail::exception_handling::policy_concept, detail::thread_task_executor_policies_config, Policies_...>::type;
+        template < template <typename> class PolicyConcept_ >
+        using policy = typename detail::policy_picker<PolicyConcept_, detail::thread_task_executor_policies_config, Policies_...>::type;
 
-        using task_queue = std::queue<std::function<void()>>;
+        using exception_handling_policy = policy<detail::exception_handling::policy_concept>;
+        using task_queue_policy = policy<detail::task_queue::policy_concept>;
+        using instrumentation_policy = policy<detail::instrumentation::policy_concept>;
+
+        using task_queue = typename task_queue_policy::queue;
+        using recorder = typename instrumentation_policy::recorder;
+
+        struct delayed_task
+        {
+            clock::time_point           deadline;
+            std::function<void()>       task;
+
+            delayed_task(clock::time_point deadline, std::function<void()> task)
+                : deadline(deadline), task(std::move(task))
+            { }
+
+            bool operator < (const delayed_task& other) const
+            { return deadline > other.deadline; }
+        };
 
     private:
-        task_queue                  _tasks;
-        bool                        _alive;
-        std::mutex                  _mutex;
-        std::condition_variable     _cv;
-        std::thread                 _thread;
+        recorder                        _recorder;
+        task_queue                      _tasks;
+        std::vector<delayed_task>       _delayed_tasks;
+        bool                            _alive;
+        bool                            _waiting;
+        mutable std::mutex              _mutex;
+        std::condition_variable         _cv;
+        std::atomic<std::thread::id>    _thread_id;
+        std::thread                     _thread;
 
     public:
-        template < typename... Args_ >
-        basic_thread_task_executor(Args_&... args)
-            : exception_handling_policy(std::forward<Args_>(args)...), _alive(true)
-        { _thread = std::thread(&basic_thread_task_executor::thread_func, this); }
+        template < typename... Args_, typename = typename std::enable_if<std::is_constructible<exception_handling_policy, Args_&&...>::value>::type >
+        basic_thread_task_executor(Args_&&... args)
+            : basic_thread_task_executor(wigwag::task_queue::args(), detail::make_index_sequence<0>(), std::forward<Args_>(args)...)
+        { }
+
+        template < typename... QueueArgs_, typename... Args_, typename = typename std::enable_if<std::is_constructible<exception_handling_policy, Args_&&...>::value>::type >
+        basic_thread_task_executor(wigwag::task_queue::arguments<QueueArgs_...> queue_args, Args_&&... args)
+            : basic_thread_task_executor(std::move(queue_args), detail::make_index_sequence<sizeof...(QueueArgs_)>(), std::forward<Args_>(args)...)
+        { }
 
         ~basic_thread_task_executor()
         {
@@ -68,37 +107,88 @@ namespace wigwag
 
         virtual void add_task(std::function<void()> task)
         {
-            std::lock_guard<std::mutex> l(_mutex);
-            bool need_wakeup = _tasks.empty();
-            _tasks.push(std::move(task));
-            if (need_wakeup)
+            task = _recorder.wrap_task(std::move(task));
+
+            std::unique_lock<std::mutex> l(_mutex);
+            _tasks.push(std::move(task), l, !is_current());
+            _recorder.task_queued(_tasks.size());
+            if (_waiting)
+                _cv.notify_all();
+        }
+
+        // The task runs when it is due, bypassing the task queue policy, and the ones that are not due when the executor is
+        // destroyed are dropped
+        virtual void add_task_at(clock::time_point deadline, std::function<void()> task)
+        {
+            std::unique_lock<std::mutex> l(_mutex);
+            _delayed_tasks.push_back(delayed_task(deadline, std::move(task)));
+            std::push_heap(_delayed_tasks.begin(), _delayed_tasks.end());
+            if (_waiting)
                 _cv.notify_all();
         }
 
+        virtual bool is_current() const
+        { return _thread_id.load(std::memory_order_relaxed) == std::this_thread::get_id(); }
+
+        task_queue_statistics get_queue_statistics() const
+        {
+            std::lock_guard<std::mutex> l(_mutex);
+            return _tasks.get_statistics();
+        }
+
+        template < typename Recorder_ = recorder >
+        auto get_task_statistics() const -> decltype(std::declval<const Recorder_&>().get_statistics())
+        { return _recorder.get_statistics(); }
+
     private:
+        template < typename... QueueArgs_, std::size_t... Indices_, typename... Args_ >
+        basic_thread_task_executor(wigwag::task_queue::arguments<QueueArgs_...>&& queue_args, detail::index_sequence<Indices_...>, Args_&&... args)
+            : exception_handling_policy(std::forward<Args_>(args)...), _tasks(std::get<Indices_>(std::move(queue_args.values))...), _delayed_tasks(), _alive(true), _waiting(false), _thread_id(std::thread::id())
+        { _thread = std::thread(&basic_thread_task_executor::thread_func, this); }
+
         void thread_func()
         {
+            _thread_id.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
             std::unique_lock<std::mutex> l(_mutex);
             while (_alive || !_tasks.empty())
             {
-                if (_tasks.empty())
+                bool delayed_task_due = _alive && !_delayed_tasks.empty() && _delayed_tasks.front().deadline <= clock::now();
+
+                if (!delayed_task_due && _tasks.empty())
                 {
-                    _cv.wait(l);
+                    _waiting = true;
+                    if (_alive && !_delayed_tasks.empty())
+                        _cv.wait_until(l, _delayed_tasks.front().deadline);
+                    else
+                        _cv.wait(l);
+                    _waiting = false;
                     continue;
                 }
 
                 exception_handling_policy::handle_exceptions([&]() {
-                        std::function<void()> task;
-                        std::swap(_tasks.front(), task);
-                        _tasks.pop();
+                        std::function<void()> task = delayed_task_due ? pop_delayed_task() : _tasks.pop();
 
                         l.unlock();
                         auto sg = detail::at_scope_exit([&] { l.lock(); } );
 
+                        WIGWAG_PROBE1(executor__task__start, this);
+                        auto probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE1(executor__task__end, this); } );
+                        WIGWAG_TRACE_SCOPE("executor task", this);
                         task();
                     } );
             }
         }
+
+        // The due delayed tasks are executed before the queued ones and bypass the queue, so a bounded queue policy never
+        // drops or coalesces them (the stages that reschedule themselves, like debounce, would stop otherwise)
+        std::function<void()> pop_delayed_task()
+        {
+            std::pop_heap(_delayed_tasks.begin(), _delayed_tasks.end());
+            std::function<void()> task = _recorder.wrap_task(std::move(_delayed_tasks.back().task));
+            _delayed_tasks.pop_back();
+            return task;
+        }
     };
 
 
@@ -11,13 +11,17 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/detail/at_scope_exit.hpp>
+#include <wigwag/detail/config.hpp>
 #include <wigwag/detail/policies_concepts.hpp>
 #include <wigwag/detail/policy_picker.hpp>
+#include <wigwag/detail/probes.hpp>
+#include <wigwag/detail/tracing.hpp>
 #include <wigwag/policies.hpp>
 #include <wigwag/task_executor.hpp>
 
 #include <queue>
-#include <thread>
+#include <utility>
 
 
 namespace wigwag
@@ -29,8 +33,24 @@ namespace wigwag
     {
         using threadless_task_executor_policies_config = policies_config<
                 policies_config_entry<exception_handling::policy_concept, wigwag::exception_handling::default_>,
-                policies_config_entry<threading::policy_concept, wigwag::threading::default_>
+                policies_config_entry<threading::policy_concept, wigwag::threading::default_>,
+                policies_config_entry<instrumentation::policy_concept, wigwag::instrumentation::default_>
             >;
+
+
+        // Lives on the stack of process_tasks, the executors that are processing tasks on the thread form a list
+        struct processing_executor
+        {
+            const task_executor*    executor;
+            processing_executor*    prev;
+        };
+
+        template < typename Dummy_ = void >
+        struct processing_executor_tls
+        { static WIGWAG_THREAD_LOCAL processing_executor* current; };
+
+        template < typename Dummy_ >
+        WIGWAG_THREAD_LOCAL processing_executor* processing_executor_tls<Dummy_>::current = nullptr;
     }
 
 
@@ -44,14 +64,17 @@ namespace wigwag
 
         using exception_handling_policy = policy<detail::exception_handling::policy_concept>;
         using threading_policy = policy<detail::threading::policy_concept>;
+        using instrumentation_policy = policy<detail::instrumentation::policy_concept>;
 
         using task_queue = std::queue<std::function<void()>>;
 
         using lock_primitive = typename threading_policy::lock_primitive;
+        using recorder = typename instrumentation_policy::recorder;
 
     private:
-        task_queue              _tasks;
-        lock_primitive          _lp;
+        recorder                        _recorder;
+        task_queue                      _tasks;
+        lock_primitive                  _lp;
 
     public:
         template < typename... Args_ >
@@ -64,14 +87,34 @@ namespace wigwag
 
         virtual void add_task(std::function<void()> task)
         {
+            task = _recorder.wrap_task(std::move(task));
+
             _lp.lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
 
             _tasks.push(std::move(task));
+            _recorder.task_queued(_tasks.size());
         }
 
+        // True only inside process_tasks, on the thread that called it
+        virtual bool is_current() const
+        {
+            for (const detail::processing_executor* e = detail::processing_executor_tls<>::current; e; e = e->prev)
+                if (e->executor == this)
+                    return true;
+            return false;
+        }
+
+        template < typename Recorder_ = recorder >
+        auto get_task_statistics() const -> decltype(std::declval<const Recorder_&>().get_statistics())
+        { return _recorder.get_statistics(); }
+
         void process_tasks()
         {
+            detail::processing_executor processing = { this, detail::processing_executor_tls<>::current };
+            detail::processing_executor_tls<>::current = &processing;
+            auto processing_sg = detail::at_scope_exit([&] { detail::processing_executor_tls<>::current = processing.prev; } );
+
             _lp.lock_nonrecursive();
             auto sg = detail::at_scope_exit([&] { _lp.unlock_nonrecursive(); } );
 
@@ -85,6 +128,9 @@ namespace wigwag
                         _lp.unlock_nonrecursive();
                         auto sg = detail::at_scope_exit([&] { _lp.lock_nonrecursive(); } );
 
+                        WIGWAG_PROBE1(executor__task__start, this);
+                        auto probe_sg = detail::at_scope_exit([&] { WIGWAG_PROBE1(executor__task__end, this); } );
+                        WIGWAG_TRACE_SCOPE("executor task", this);
                         task();
                     } );
             }
@@ -0,0 +1,76 @@
+#ifndef WIGWAG_TRACING_HPP
+#define WIGWAG_TRACING_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/trace_recorder.hpp>
+
+#include <fstream>
+#include <ostream>
+#include <string>
+
+
+namespace wigwag {
+namespace tracing
+{
+
+#include <wigwag/detail/disable_warnings.hpp>
+
+    // Signal emissions, handler calls and asynchronous task hops are recorded only if the code is compiled with WIGWAG_USE_CHROME_TRACING=1
+    inline void start() { detail::trace_recorder::instance().set_enabled(true); }
+    inline void stop() { detail::trace_recorder::instance().set_enabled(false); }
+    inline bool is_running() { return detail::trace_recorder::instance().enabled(); }
+
+
+    // Writes the events that were recorded since the previous write. The result can be opened in chrome://tracing or Perfetto
+    inline void write_chrome_trace(std::ostream& os)
+    { detail::trace_recorder::instance().write_chrome_trace(os); }
+
+    inline bool write_chrome_trace(const std::string& filename)
+    {
+        std::ofstream f(filename.c_str());
+        if (!f)
+            return false;
+        write_chrome_trace(f);
+        return (bool)f;
+    }
+
+
+    // Marks a scope of the user code on the trace timeline
+    class scope
+    {
+    private:
+        const char*     _name;
+        bool            _recorded;
+
+    public:
+        explicit scope(const char* name)
+            : _name(name), _recorded(is_running())
+        {
+            if (_recorded)
+                detail::trace_recorder::instance().record('B', _name, nullptr);
+        }
+
+        ~scope()
+        {
+            if (_recorded)
+                detail::trace_recorder::instance().record('E', _name, nullptr);
+        }
+
+        scope(const scope&) = delete;
+        scope& operator = (const scope&) = delete;
+    };
+
+#include <wigwag/detail/enable_warnings.hpp>
+
+}}
+
+#endif
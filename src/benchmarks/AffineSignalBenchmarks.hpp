@@ -0,0 +1,78 @@
+#ifndef SRC_BENCHMARKS_AFFINESIGNALBENCHMARKS_HPP
+#define SRC_BENCHMARKS_AFFINESIGNALBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <wigwag/threadless_task_executor.hpp>
+
+#include <memory>
+
+
+namespace benchmarks
+{
+
+    // Delivering the emissions to the handlers on the thread of the worker. The signal is emitted either outside of the
+    // worker tasks (so the emissions are marshalled) or from a worker task
+    template < typename AffineSignalDesc_ >
+    class AffineSignalBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename AffineSignalDesc_::SignalType;
+        using ConnectionType = typename AffineSignalDesc_::ConnectionType;
+        using ExecutorType = wigwag::threadless_task_executor;
+
+    public:
+        AffineSignalBenchmarks()
+            : BenchmarksClass("affine_signal")
+        {
+            AddBenchmark<int64_t>("affineInvoke", &AffineSignalBenchmarks::AffineInvoke, {"numSlots"});
+            AddBenchmark<int64_t>("ownerInvoke", &AffineSignalBenchmarks::OwnerInvoke, {"numSlots"});
+        }
+
+    private:
+        static void AffineInvoke(BenchmarkContext& context, int64_t numSlots)
+        {
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            std::unique_ptr<SignalType> s(AffineSignalDesc_::MakeSignal(worker));
+            Deliver(context, numSlots, worker, *s, false);
+        }
+
+        static void OwnerInvoke(BenchmarkContext& context, int64_t numSlots)
+        {
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            std::unique_ptr<SignalType> s(AffineSignalDesc_::MakeSignal(worker));
+            Deliver(context, numSlots, worker, *s, true);
+        }
+
+        static void Deliver(BenchmarkContext& context, int64_t numSlots, const std::shared_ptr<ExecutorType>& worker, SignalType& s, bool fromWorker)
+        {
+            const auto n = context.GetIterationsCount();
+
+            StorageArray<ConnectionType> c(numSlots);
+            c.Construct([&]{ return AffineSignalDesc_::Connect(s, worker, [](int64_t) { }); });
+
+            {
+                auto op = context.Profile("deliver", numSlots * n);
+                auto emit = [&] { for (int64_t i = 0; i < n; ++i) s(i); };
+                if (fromWorker)
+                    worker->add_task(emit);
+                else
+                    emit();
+                worker->process_tasks();
+            }
+
+            c.Destruct();
+        }
+    };
+
+}
+
+#endif
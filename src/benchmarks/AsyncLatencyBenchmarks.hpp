@@ -0,0 +1,84 @@
+#ifndef SRC_BENCHMARKS_ASYNCLATENCYBENCHMARKS_HPP
+#define SRC_BENCHMARKS_ASYNCLATENCYBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    // Time from emitting a signal on the producer thread to the start of its handler on the executor thread.
+    // The producer runs at a fixed rate (one emission per intervalNs) and stamps every emission with its scheduled time, so
+    // a stalled producer does not hide the latency of the emissions it was late for.
+    template < typename AsyncLatencyDesc_ >
+    class AsyncLatencyBenchmarks : public BenchmarksClass
+    {
+        using Clock = std::chrono::steady_clock;
+
+    public:
+        AsyncLatencyBenchmarks()
+            : BenchmarksClass("async_latency")
+        {
+            AddBenchmark<int64_t>("delivery", &AsyncLatencyBenchmarks::Delivery, {"intervalNs"});
+        }
+
+    private:
+        static int64_t Now()
+        { return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count(); }
+
+        static void Delivery(BenchmarkContext& context, int64_t intervalNs)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::vector<int64_t> latencies(n);
+            int64_t received = 0;
+
+            {
+                auto channel = AsyncLatencyDesc_::MakeChannel([&](int64_t sentNs) { latencies[received++] = Now() - sentNs; });
+
+                int64_t next = Now();
+                for (int64_t i = 0; i < n; ++i)
+                {
+                    if (intervalNs > 0)
+                    {
+                        next += intervalNs;
+                        while (Now() < next)
+                            ;
+                        channel->Emit(next);
+                    }
+                    else
+                        channel->Emit(Now());
+                }
+
+                channel->Drain();
+            }
+
+            latencies.resize(received);
+            std::sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) { return latencies.empty() ? 0.0 : (double)latencies[std::min<std::size_t>(latencies.size() - 1, (std::size_t)(p * latencies.size()))]; };
+
+            context.ReportTime("p50", percentile(0.5));
+            context.ReportTime("p99", percentile(0.99));
+            context.ReportTime("p99.9", percentile(0.999));
+            context.ReportTime("max", latencies.empty() ? 0.0 : (double)latencies.back());
+        }
+    };
+
+}
+
+#endif
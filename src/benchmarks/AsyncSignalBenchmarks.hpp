@@ -0,0 +1,89 @@
+#ifndef SRC_BENCHMARKS_ASYNCSIGNALBENCHMARKS_HPP
+#define SRC_BENCHMARKS_ASYNCSIGNALBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <memory>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    template < typename AsyncSignalsDesc_ >
+    class AsyncSignalBenchmarks : public BenchmarksClass
+    {
+        using PayloadType = std::vector<char>;
+        using SignalType = typename AsyncSignalsDesc_::template SignalType<void(const PayloadType&)>;
+        using ExecutorType = typename AsyncSignalsDesc_::ExecutorType;
+        using ConnectionType = typename AsyncSignalsDesc_::ConnectionType;
+
+    public:
+        AsyncSignalBenchmarks()
+            : BenchmarksClass("async_signal")
+        {
+            AddBenchmark<int64_t, int64_t>("asyncFanout", &AsyncSignalBenchmarks::AsyncFanout, {"argSize", "numSlots"});
+            AddBenchmark<int64_t>("sameThreadInvoke", &AsyncSignalBenchmarks::SameThreadInvoke, {"numSlots"});
+        }
+
+    private:
+        static void AsyncFanout(BenchmarkContext& context, int64_t argSize, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            PayloadType payload(argSize);
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect(worker, [](const PayloadType&) { }); });
+
+            {
+                auto op = context.Profile("invoke", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    s(payload);
+            }
+            context.Profile("process", numSlots * n, [&]{ AsyncSignalsDesc_::ProcessTasks(*worker); });
+
+            c.Destruct();
+        }
+
+        static void SameThreadInvoke(BenchmarkContext& context, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            PayloadType payload;
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect(worker, [](const PayloadType&) { }, AsyncSignalsDesc_::GetAttributes()); });
+
+            {
+                auto op = context.Profile("deliver", numSlots * n);
+                worker->add_task([&]{
+                        for (int64_t i = 0; i < n; ++i)
+                            s(payload);
+                    });
+                AsyncSignalsDesc_::ProcessTasks(*worker);
+                AsyncSignalsDesc_::ProcessTasks(*worker);
+            }
+
+            c.Destruct();
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef SRC_BENCHMARKS_AWAITBENCHMARKS_HPP
+#define SRC_BENCHMARKS_AWAITBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+
+namespace benchmarks
+{
+
+    // A consumer that waits for the emissions of a signal one by one. Prepare is called before each emission, and
+    // Complete after it
+    template < typename AwaitDesc_ >
+    class AwaitBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename AwaitDesc_::SignalType;
+        using ConsumerType = typename AwaitDesc_::Consumer;
+
+    public:
+        AwaitBenchmarks()
+            : BenchmarksClass("await")
+        {
+            AddBenchmark<>("next", &AwaitBenchmarks::Next);
+        }
+
+    private:
+        static void Next(BenchmarkContext& context)
+        {
+            const auto n = context.GetIterationsCount();
+
+            SignalType s;
+            ConsumerType consumer(s, n);
+
+            auto op = context.Profile("await", n);
+            for (int64_t i = 0; i < n; ++i)
+            {
+                consumer.Prepare();
+                s((int)i);
+                consumer.Complete();
+            }
+        }
+    };
+
+}
+
+#endif
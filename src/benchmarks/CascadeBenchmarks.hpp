@@ -0,0 +1,62 @@
+#ifndef SRC_BENCHMARKS_CASCADEBENCHMARKS_HPP
+#define SRC_BENCHMARKS_CASCADEBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+
+namespace benchmarks
+{
+
+    // A chain of depth signals, each of them emitting the next one from its handler
+    template < typename CascadeDesc_ >
+    class CascadeBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename CascadeDesc_::SignalType;
+        using ConnectionType = typename CascadeDesc_::ConnectionType;
+
+    public:
+        CascadeBenchmarks()
+            : BenchmarksClass("cascade")
+        {
+            AddBenchmark<int64_t>("invoke", &CascadeBenchmarks::Invoke, {"depth"});
+        }
+
+    private:
+        static void Invoke(BenchmarkContext& context, int64_t depth)
+        {
+            const auto n = context.GetIterationsCount();
+
+            StorageArray<SignalType> s(depth);
+            StorageArray<ConnectionType> c(depth);
+            for (int64_t i = 0; i < depth; ++i)
+                s[i].Construct(CascadeDesc_::GetAttributes());
+            for (int64_t i = 0; i + 1 < depth; ++i)
+            {
+                SignalType& next = s[i + 1].Ref();
+                c[i].Construct(s[i].Ref().connect([&next]{ next(); }));
+            }
+            c[depth - 1].Construct(s[depth - 1].Ref().connect([]{ }));
+
+            {
+                auto op = context.Profile("invoke", depth * n);
+                for (int64_t i = 0; i < n; ++i)
+                    s[0].Ref()();
+            }
+
+            c.Destruct();
+            s.Destruct();
+        }
+    };
+
+}
+
+#endif
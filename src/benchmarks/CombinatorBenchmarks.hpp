@@ -0,0 +1,118 @@
+#ifndef SRC_BENCHMARKS_COMBINATORBENCHMARKS_HPP
+#define SRC_BENCHMARKS_COMBINATORBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <wigwag/derived_signal.hpp>
+#include <wigwag/signal.hpp>
+#include <wigwag/thread_task_executor.hpp>
+
+#include <chrono>
+#include <memory>
+
+
+namespace benchmarks
+{
+
+    // Every benchmark emits the source through map, the combinator, and map again. The measured cost is the one of an
+    // emission per handler, the delayed deliveries of debounce and sample happen on the worker thread
+    template < typename CombinatorDesc_ >
+    class CombinatorBenchmarks : public BenchmarksClass
+    {
+        using SignalType = wigwag::signal<void(int)>;
+        using ChainType = typename CombinatorDesc_::Chain;
+        using ExecutorType = wigwag::thread_task_executor;
+
+        struct Inc { int operator() (int i) const { return i + 1; } };
+        struct Dec { int operator() (int i) const { return i - 1; } };
+        struct IsEven { bool operator() (int i) const { return i % 2 == 0; } };
+
+    public:
+        CombinatorBenchmarks()
+            : BenchmarksClass("combinator")
+        {
+            AddBenchmark<int64_t>("filter", &CombinatorBenchmarks::Filter, {"numSlots"});
+            AddBenchmark<int64_t>("map", &CombinatorBenchmarks::Map, {"numSlots"});
+            AddBenchmark<int64_t>("throttle", &CombinatorBenchmarks::Throttle, {"numSlots"});
+            AddBenchmark<int64_t>("debounce", &CombinatorBenchmarks::Debounce, {"numSlots"});
+            AddBenchmark<int64_t>("sample", &CombinatorBenchmarks::Sample, {"numSlots"});
+            AddBenchmark<int64_t>("merge", &CombinatorBenchmarks::Merge, {"numSlots"});
+        }
+
+    private:
+        static void Filter(BenchmarkContext& context, int64_t numSlots)
+        {
+            SignalType s;
+            ChainType c;
+            Emit(context, numSlots, c(c(c(wigwag::derive(s).map(Inc())).filter(IsEven())).map(Dec())), [&](int i) { s(i); });
+        }
+
+        static void Map(BenchmarkContext& context, int64_t numSlots)
+        {
+            SignalType s;
+            ChainType c;
+            Emit(context, numSlots, c(c(c(wigwag::derive(s).map(Inc())).map(Inc())).map(Dec())), [&](int i) { s(i); });
+        }
+
+        static void Throttle(BenchmarkContext& context, int64_t numSlots)
+        {
+            SignalType s;
+            ChainType c;
+            Emit(context, numSlots, c(c(c(wigwag::derive(s).map(Inc())).throttle(std::chrono::milliseconds(1))).map(Dec())), [&](int i) { s(i); });
+        }
+
+        static void Debounce(BenchmarkContext& context, int64_t numSlots)
+        {
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            SignalType s;
+            ChainType c;
+            Emit(context, numSlots, c(c(c(wigwag::derive(s).map(Inc())).debounce(std::chrono::milliseconds(1), worker)).map(Dec())), [&](int i) { s(i); });
+        }
+
+        static void Sample(BenchmarkContext& context, int64_t numSlots)
+        {
+            std::shared_ptr<ExecutorType> worker = std::make_shared<ExecutorType>();
+            SignalType s;
+            ChainType c;
+            Emit(context, numSlots, c(c(c(wigwag::derive(s).map(Inc())).sample(worker, std::chrono::milliseconds(1))).map(Dec())), [&](int i) { s(i); });
+        }
+
+        static void Merge(BenchmarkContext& context, int64_t numSlots)
+        {
+            SignalType s1, s2;
+            ChainType c;
+            Emit(context, numSlots, c(c(merge(c(wigwag::derive(s1).map(Inc())), c(wigwag::derive(s2).map(Inc())))).map(Dec())), [&](int i) { if (i % 2) s1(i); else s2(i); });
+        }
+
+        template < typename Derived_, typename EmitFunc_ >
+        static void Emit(BenchmarkContext& context, int64_t numSlots, const Derived_& d, const EmitFunc_& emit)
+        {
+            const auto n = context.GetIterationsCount();
+
+            StorageArray<wigwag::token> t(numSlots);
+            t.Construct([&]{ return d.connect([](int) { }); });
+
+            {
+                auto op = context.Profile("emit", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    emit((int)i);
+            }
+
+            t.Destruct();
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef SRC_BENCHMARKS_CONCURRENTCONNECTBENCHMARKS_HPP
+#define SRC_BENCHMARKS_CONCURRENTCONNECTBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    // numThreads threads connecting handlers to the same signal at once
+    template < typename ConcurrentConnectDesc_ >
+    class ConcurrentConnectBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename ConcurrentConnectDesc_::SignalType;
+        using HandlerType = typename ConcurrentConnectDesc_::HandlerType;
+        using ConnectionType = typename ConcurrentConnectDesc_::ConnectionType;
+
+    public:
+        ConcurrentConnectBenchmarks()
+            : BenchmarksClass("concurrent_connect")
+        {
+            AddBenchmark<int64_t>("connect", &ConcurrentConnectBenchmarks::Connect, {"numThreads"});
+        }
+
+    private:
+        static void Connect(BenchmarkContext& context, int64_t numThreads)
+        {
+            const auto n = context.GetIterationsCount();
+
+            HandlerType handler = ConcurrentConnectDesc_::MakeHandler();
+            SignalType s(ConcurrentConnectDesc_::MakeSignal());
+            StorageArray<ConnectionType> c(numThreads * n);
+
+            std::atomic<bool> started(false);
+            std::vector<std::thread> threads;
+            for (int64_t t = 0; t < numThreads; ++t)
+                threads.emplace_back([&, t]
+                    {
+                        while (!started)
+                            std::this_thread::yield();
+                        for (int64_t i = 0; i < n; ++i)
+                            c[t * n + i].Construct(s.connect(handler));
+                    });
+
+            {
+                auto op = context.Profile("connect", numThreads * n);
+                started = true;
+                for (auto& th : threads)
+                    th.join();
+            }
+
+            s();
+            context.Profile("disconnect", numThreads * n, [&]{ c.Destruct(); });
+        }
+    };
+
+}
+
+#endif
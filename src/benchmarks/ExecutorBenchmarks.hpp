@@ -0,0 +1,62 @@
+#ifndef SRC_BENCHMARKS_EXECUTORBENCHMARKS_HPP
+#define SRC_BENCHMARKS_EXECUTORBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <array>
+#include <chrono>
+
+
+namespace benchmarks
+{
+
+    template < typename ExecutorDesc_ >
+    class ExecutorBenchmarks : public BenchmarksClass
+    {
+        using Payload = std::array<char, 256>;
+
+    public:
+        ExecutorBenchmarks()
+            : BenchmarksClass("executor")
+        {
+            AddBenchmark<int64_t>("slowConsumer", &ExecutorBenchmarks::SlowConsumer, {"taskDurationUs"});
+        }
+
+    private:
+        static void SlowConsumer(BenchmarkContext& context, int64_t taskDurationUs)
+        {
+            const auto n = context.GetIterationsCount();
+            const auto taskDuration = std::chrono::microseconds(taskDurationUs);
+
+            auto worker = ExecutorDesc_::MakeExecutor();
+            Payload payload = Payload();
+
+            {
+                auto op = context.Profile("addTask", n);
+                for (int64_t i = 0; i < n; ++i)
+                    worker->add_task([payload, taskDuration]
+                        {
+                            auto end = std::chrono::steady_clock::now() + taskDuration;
+                            while (std::chrono::steady_clock::now() < end)
+                                ;
+                        });
+            }
+
+            context.MeasureMemory("queue", n);
+            context.Profile("drain", n, [&]{ worker.reset(); });
+        }
+    };
+
+}
+
+#endif
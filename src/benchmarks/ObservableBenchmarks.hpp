@@ -0,0 +1,112 @@
+#ifndef SRC_BENCHMARKS_OBSERVABLEBENCHMARKS_HPP
+#define SRC_BENCHMARKS_OBSERVABLEBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <algorithm>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    // An observable collection of `size` int64_t keys. update changes one key and notifies the handlers, batchUpdate does
+    // the same in batches of batchSize updates, snapshot takes a copy of the state that stays valid after further updates,
+    // and populate connects a handler that gets the whole state
+    template < typename ObservableDesc_ >
+    class ObservableBenchmarks : public BenchmarksClass
+    {
+        using CollectionType = typename ObservableDesc_::CollectionType;
+        using ConnectionType = typename ObservableDesc_::ConnectionType;
+
+    public:
+        ObservableBenchmarks()
+            : BenchmarksClass("observable")
+        {
+            AddBenchmark<int64_t, int64_t>("update", &ObservableBenchmarks::Update, {"size", "numSlots"});
+            AddBenchmark<int64_t, int64_t, int64_t>("batchUpdate", &ObservableBenchmarks::BatchUpdate, {"size", "numSlots", "batchSize"});
+            AddBenchmark<int64_t>("snapshot", &ObservableBenchmarks::Snapshot, {"size"});
+            AddBenchmark<int64_t>("populate", &ObservableBenchmarks::Populate, {"size"});
+        }
+
+    private:
+        static void Update(BenchmarkContext& context, int64_t size, int64_t numSlots)
+        {
+            const auto n = context.GetIterationsCount();
+
+            CollectionType c(size);
+            int64_t sink = 0;
+            StorageArray<ConnectionType> connections(numSlots);
+            connections.Construct([&]{ return ObservableDesc_::Connect(c, [&](int64_t v) { sink += v; }); });
+
+            {
+                auto op = context.Profile("update", n);
+                for (int64_t i = 0; i < n; ++i)
+                    ObservableDesc_::Update(c, (i * 7919) % size, i);
+            }
+
+            connections.Destruct();
+        }
+
+        static void BatchUpdate(BenchmarkContext& context, int64_t size, int64_t numSlots, int64_t batchSize)
+        {
+            const auto n = context.GetIterationsCount();
+
+            CollectionType c(size);
+            int64_t sink = 0;
+            StorageArray<ConnectionType> connections(numSlots);
+            connections.Construct([&]{ return ObservableDesc_::Connect(c, [&](int64_t v) { sink += v; }); });
+
+            {
+                auto op = context.Profile("update", n);
+                for (int64_t i = 0; i < n; i += batchSize)
+                {
+                    ObservableDesc_::BeginUpdate(c);
+                    for (int64_t j = i; j < std::min(i + batchSize, n); ++j)
+                        ObservableDesc_::Update(c, (j * 7919) % size, j);
+                    ObservableDesc_::EndUpdate(c);
+                }
+            }
+
+            connections.Destruct();
+        }
+
+        static void Snapshot(BenchmarkContext& context, int64_t size)
+        {
+            const auto n = context.GetIterationsCount();
+
+            CollectionType c(size);
+            std::vector<typename ObservableDesc_::SnapshotType> snapshots(n);
+
+            auto op = context.Profile("snapshot", n);
+            for (int64_t i = 0; i < n; ++i)
+                snapshots[i] = ObservableDesc_::GetSnapshot(c);
+        }
+
+        static void Populate(BenchmarkContext& context, int64_t size)
+        {
+            const auto n = context.GetIterationsCount();
+
+            CollectionType c(size);
+            int64_t sink = 0;
+
+            auto op = context.Profile("populate", n);
+            for (int64_t i = 0; i < n; ++i)
+                ConnectionType t = ObservableDesc_::Connect(c, [&](int64_t v) { sink += v; });
+        }
+    };
+
+}
+
+#endif
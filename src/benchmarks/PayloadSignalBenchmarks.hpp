@@ -0,0 +1,64 @@
+#ifndef SRC_BENCHMARKS_PAYLOADSIGNALBENCHMARKS_HPP
+#define SRC_BENCHMARKS_PAYLOADSIGNALBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+#include <benchmarks/utils/Storage.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    template < typename PayloadSignalsDesc_ >
+    class PayloadSignalBenchmarks : public BenchmarksClass
+    {
+        using ConnectionType = typename PayloadSignalsDesc_::ConnectionType;
+
+    public:
+        PayloadSignalBenchmarks()
+            : BenchmarksClass("payload_signal")
+        {
+            AddBenchmark<int64_t, int64_t>("invokeString", &PayloadSignalBenchmarks::Invoke<std::string>, {"payloadSize", "numSlots"});
+            AddBenchmark<int64_t, int64_t>("invokeVector", &PayloadSignalBenchmarks::Invoke<std::vector<char>>, {"payloadSize", "numSlots"});
+        }
+
+    private:
+        template < typename Payload_ >
+        static void Invoke(BenchmarkContext& context, int64_t payloadSize, int64_t numSlots)
+        {
+            using SignalType = typename PayloadSignalsDesc_::template SignalType<void(Payload_)>;
+
+            const auto n = context.GetIterationsCount();
+
+            const Payload_ payload(payloadSize, 'a');
+            Payload_ sink;
+            SignalType s;
+            StorageArray<ConnectionType> c(numSlots);
+
+            c.Construct([&]{ return s.connect([&](Payload_ p) { sink = std::move(p); }); });
+
+            {
+                auto op = context.Profile("invoke", numSlots * n);
+                for (int64_t i = 0; i < n; ++i)
+                    PayloadSignalsDesc_::Invoke(s, Payload_(payload));
+            }
+
+            c.Destruct();
+        }
+    };
+
+}
+
+#endif
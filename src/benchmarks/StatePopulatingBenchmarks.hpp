@@ -0,0 +1,75 @@
+#ifndef SRC_BENCHMARKS_STATEPOPULATINGBENCHMARKS_HPP
+#define SRC_BENCHMARKS_STATEPOPULATINGBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace benchmarks
+{
+
+    // Connecting handlers that are populated with a state of stateSize items while another thread keeps modifying the
+    // state and emitting the signal. Reports the connect time and the time per emission of the other thread meanwhile
+    template < typename StatePopulatingDesc_ >
+    class StatePopulatingBenchmarks : public BenchmarksClass
+    {
+        using Clock = std::chrono::steady_clock;
+        using ObservableType = typename StatePopulatingDesc_::ObservableType;
+
+    public:
+        StatePopulatingBenchmarks()
+            : BenchmarksClass("state_populating")
+        {
+            AddBenchmark<int64_t>("connectUnderLoad", &StatePopulatingBenchmarks::ConnectUnderLoad, {"stateSize"});
+        }
+
+    private:
+        static void ConnectUnderLoad(BenchmarkContext& context, int64_t stateSize)
+        {
+            const auto n = context.GetIterationsCount();
+
+            ObservableType o(stateSize);
+            std::atomic<bool> alive(true);
+            std::atomic<int64_t> emitted(0);
+
+            std::thread emitter([&]
+                {
+                    for (int64_t i = 0; alive; ++i)
+                    {
+                        o.Update(i % stateSize, i);
+                        emitted.store(i + 1, std::memory_order_relaxed);
+                    }
+                });
+
+            int64_t sink = 0;
+            int64_t emittedBefore = emitted.load();
+            auto start = Clock::now();
+            {
+                auto op = context.Profile("connect", n);
+                for (int64_t i = 0; i < n; ++i)
+                    auto t = o.Connect([&](int64_t v) { sink += v; });
+            }
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            int64_t emittedDuring = emitted.load() - emittedBefore;
+
+            alive = false;
+            emitter.join();
+
+            context.ReportTime("emit", emittedDuring > 0 ? (double)duration / emittedDuring : (double)duration);
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SRC_BENCHMARKS_STREAMBENCHMARKS_HPP
+#define SRC_BENCHMARKS_STREAMBENCHMARKS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+
+namespace benchmarks
+{
+
+    // A producer that emits as fast as it can and a consumer on another thread that keeps only the newest emissions if
+    // it falls behind by more than capacity. The consumer always gets the last emission
+    template < typename StreamDesc_ >
+    class StreamBenchmarks : public BenchmarksClass
+    {
+        using SignalType = typename StreamDesc_::SignalType;
+        using ConsumerType = typename StreamDesc_::Consumer;
+
+    public:
+        StreamBenchmarks()
+            : BenchmarksClass("stream")
+        {
+            AddBenchmark<int64_t>("throughput", &StreamBenchmarks::Throughput, {"capacity"});
+        }
+
+    private:
+        static void Throughput(BenchmarkContext& context, int64_t capacity)
+        {
+            const auto n = context.GetIterationsCount();
+
+            SignalType s;
+            ConsumerType consumer(s, capacity, (int)n - 1);
+
+            {
+                auto op = context.Profile("deliver", n);
+                for (int64_t i = 0; i < n; ++i)
+                    s((int)i);
+                consumer.Wait();
+            }
+
+            context.ReportCounter("deliver.dropped", double(consumer.GetDroppedCount()) / double(n));
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_AFFINE_SIGNAL_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_AFFINE_SIGNAL_WIGWAG_HPP
+
+
+#include <wigwag/affine_signal.hpp>
+#include <wigwag/signal.hpp>
+
+#include <memory>
+#include <string>
+
+
+namespace descriptors {
+namespace affine_signal {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	// Every handler is connected to the worker, so each of them gets its own task
+	struct PerHandler
+	{
+		using SignalType = wigwag::signal<void(int64_t)>;
+		using ConnectionType = token;
+
+		static SignalType* MakeSignal(const std::shared_ptr<task_executor>&) { return new SignalType; }
+
+		template < typename Handler_ >
+		static token Connect(SignalType& s, const std::shared_ptr<task_executor>& worker, const Handler_& h) { return s.connect(worker, h); }
+
+		static std::string GetName() { return "wigwag_per_handler"; }
+	};
+
+
+	struct Affine
+	{
+		using SignalType = wigwag::affine_signal<void(int64_t)>;
+		using ConnectionType = token;
+
+		static SignalType* MakeSignal(const std::shared_ptr<task_executor>& worker) { return new SignalType(worker); }
+
+		template < typename Handler_ >
+		static token Connect(SignalType& s, const std::shared_ptr<task_executor>&, const Handler_& h) { return s.connect(h); }
+
+		static std::string GetName() { return "wigwag_affine"; }
+	};
+
+}}}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_ASYNC_LATENCY_BOOST_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_ASYNC_LATENCY_BOOST_HPP
+
+#if WIGWAG_BENCHMARKS_BOOST
+
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/signals2.hpp>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+
+namespace descriptors {
+namespace async_latency {
+namespace boost
+{
+
+	// boost.signals2 has no asynchronous handlers, so the handler posts the call to an io_context running on its own thread
+	class AsioChannel
+	{
+		using WorkGuard = ::boost::asio::executor_work_guard<::boost::asio::io_context::executor_type>;
+
+	private:
+		::boost::asio::io_context					_io;
+		WorkGuard									_work;
+		std::thread									_thread;
+		::boost::signals2::signal<void(int64_t)>	_signal;
+		::boost::signals2::scoped_connection		_connection;
+
+	public:
+		explicit AsioChannel(std::function<void(int64_t)> handler)
+			: _work(_io.get_executor()), _thread([this]{ _io.run(); })
+		{
+			_connection = _signal.connect([this, handler](int64_t timestamp)
+				{ ::boost::asio::post(_io, [handler, timestamp]{ handler(timestamp); }); });
+		}
+
+		~AsioChannel()
+		{
+			_connection.disconnect();
+			_work.reset();
+			_thread.join();
+		}
+
+		void Emit(int64_t timestamp) { _signal(timestamp); }
+
+		void Drain()
+		{
+			std::promise<void> done;
+			::boost::asio::post(_io, [&]{ done.set_value(); });
+			done.get_future().wait();
+		}
+	};
+
+
+	struct AsioPost
+	{
+		using ChannelType = AsioChannel;
+
+		static std::unique_ptr<ChannelType> MakeChannel(std::function<void(int64_t)> handler)
+		{ return std::unique_ptr<ChannelType>(new ChannelType(std::move(handler))); }
+
+		static std::string GetName() { return "boost_asio"; }
+	};
+
+}}}
+
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_ASYNC_LATENCY_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_ASYNC_LATENCY_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+#include <wigwag/thread_task_executor.hpp>
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+
+
+namespace descriptors {
+namespace async_latency {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	static const std::size_t QueueCapacity = 1024;
+
+
+	template < typename ExecutorType_ >
+	class AsyncChannel
+	{
+	private:
+		std::shared_ptr<ExecutorType_>		_worker;
+		wigwag::signal<void(int64_t)>		_signal;
+		token								_token;
+
+	public:
+		AsyncChannel(std::shared_ptr<ExecutorType_> worker, std::function<void(int64_t)> handler)
+			: _worker(std::move(worker)), _token(_signal.connect(_worker, std::move(handler)))
+		{ }
+
+		void Emit(int64_t timestamp) { _signal(timestamp); }
+
+		void Drain()
+		{
+			std::promise<void> done;
+			_worker->add_task([&]{ done.set_value(); });
+			done.get_future().wait();
+		}
+	};
+
+
+	struct Unbounded
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::unbounded>;
+		using ChannelType = AsyncChannel<ExecutorType>;
+
+		static std::unique_ptr<ChannelType> MakeChannel(std::function<void(int64_t)> handler)
+		{ return std::unique_ptr<ChannelType>(new ChannelType(std::make_shared<ExecutorType>(), std::move(handler))); }
+
+		static std::string GetName() { return "wigwag_unbounded"; }
+	};
+
+
+	struct UnboundedInstrumented
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::unbounded, instrumentation::histograms>;
+		using ChannelType = AsyncChannel<ExecutorType>;
+
+		static std::unique_ptr<ChannelType> MakeChannel(std::function<void(int64_t)> handler)
+		{ return std::unique_ptr<ChannelType>(new ChannelType(std::make_shared<ExecutorType>(), std::move(handler))); }
+
+		static std::string GetName() { return "wigwag_unbounded_instrumented"; }
+	};
+
+
+	struct BlockProducer
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::block_producer>;
+		using ChannelType = AsyncChannel<ExecutorType>;
+
+		static std::unique_ptr<ChannelType> MakeChannel(std::function<void(int64_t)> handler)
+		{ return std::unique_ptr<ChannelType>(new ChannelType(std::make_shared<ExecutorType>(task_queue::args(QueueCapacity)), std::move(handler))); }
+
+		static std::string GetName() { return "wigwag_block_producer"; }
+	};
+
+}}}
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_ASYNC_SIGNAL_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_ASYNC_SIGNAL_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+#include <wigwag/thread_task_executor.hpp>
+#include <wigwag/threadless_task_executor.hpp>
+
+#include <future>
+
+
+namespace descriptors {
+namespace async_signal {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct Regular
+	{
+		template < typename Signature_ >
+		using SignalType = wigwag::signal<Signature_>;
+		using ExecutorType = threadless_task_executor;
+		using ConnectionType = token;
+
+		static handler_attributes GetAttributes() { return handler_attributes::none; }
+		static void ProcessTasks(ExecutorType& e) { e.process_tasks(); }
+		static std::string GetName() { return "wigwag"; }
+	};
+
+	struct Threaded
+	{
+		template < typename Signature_ >
+		using SignalType = wigwag::signal<Signature_>;
+		using ExecutorType = thread_task_executor;
+		using ConnectionType = token;
+
+		static handler_attributes GetAttributes() { return handler_attributes::none; }
+
+		static void ProcessTasks(ExecutorType& e)
+		{
+			std::promise<void> done;
+			e.add_task([&]{ done.set_value(); });
+			done.get_future().wait();
+		}
+
+		static std::string GetName() { return "wigwag_thread"; }
+	};
+
+	struct ThreadedInline : public Threaded
+	{
+		static handler_attributes GetAttributes() { return handler_attributes::inline_if_current; }
+		static std::string GetName() { return "wigwag_thread_inline"; }
+	};
+
+}}}
+
+#endif
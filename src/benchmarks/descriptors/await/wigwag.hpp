@@ -0,0 +1,100 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_AWAIT_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_AWAIT_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+
+#include <future>
+#include <string>
+
+#if WIGWAG_HAS_COROUTINES
+#	include <coroutine>
+#	include <exception>
+#endif
+
+
+namespace descriptors {
+namespace await {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct Promise
+	{
+		using SignalType = wigwag::signal<void(int)>;
+
+		class Consumer
+		{
+		private:
+			SignalType&			_s;
+			std::promise<int>	_promise;
+			token				_t;
+			int64_t				_sum;
+
+		public:
+			Consumer(SignalType& s, int64_t)
+				: _s(s), _promise(), _t(), _sum(0)
+			{ }
+
+			void Prepare()
+			{
+				_promise = std::promise<int>();
+				_t = _s.connect([this](int i) { _promise.set_value(i); });
+			}
+
+			void Complete()
+			{
+				_sum += _promise.get_future().get();
+				_t.reset();
+			}
+		};
+
+		static std::string GetName() { return "wigwag_promise"; }
+	};
+
+#if WIGWAG_HAS_COROUTINES
+	struct Coroutine
+	{
+		using SignalType = wigwag::signal<void(int)>;
+
+		class Consumer
+		{
+			struct Task
+			{
+				struct promise_type
+				{
+					Task get_return_object() { return Task(); }
+					std::suspend_never initial_suspend() noexcept { return {}; }
+					std::suspend_never final_suspend() noexcept { return {}; }
+					void return_void() { }
+					void unhandled_exception() { std::terminate(); }
+				};
+			};
+
+		private:
+			int64_t		_sum;
+
+		public:
+			Consumer(SignalType& s, int64_t count)
+				: _sum(0)
+			{ Receive(s, count, _sum); }
+
+			void Prepare() { }
+			void Complete() { }
+
+		private:
+			static Task Receive(SignalType& s, int64_t count, int64_t& sum)
+			{
+				for (int64_t i = 0; i < count; ++i)
+					sum += co_await s.next();
+			}
+		};
+
+		static std::string GetName() { return "wigwag_coroutine"; }
+	};
+#endif
+
+}}}
+
+#endif
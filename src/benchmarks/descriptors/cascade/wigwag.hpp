@@ -0,0 +1,38 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_CASCADE_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_CASCADE_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+
+#include <string>
+
+
+namespace descriptors {
+namespace cascade {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct DepthFirst
+	{
+		using SignalType = wigwag::signal<void()>;
+		using ConnectionType = token;
+
+		static signal_attributes GetAttributes() { return signal_attributes::none; }
+		static std::string GetName() { return "wigwag_depth_first"; }
+	};
+
+
+	struct Queued
+	{
+		using SignalType = wigwag::signal<void()>;
+		using ConnectionType = token;
+
+		static signal_attributes GetAttributes() { return signal_attributes::queued_emission; }
+		static std::string GetName() { return "wigwag_queued"; }
+	};
+
+}}}
+
+#endif
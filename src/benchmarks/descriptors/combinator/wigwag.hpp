@@ -0,0 +1,81 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_COMBINATOR_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_COMBINATOR_WIGWAG_HPP
+
+
+#include <wigwag/derived_signal.hpp>
+#include <wigwag/signal.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace descriptors {
+namespace combinator {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	// The stages are composed into a single handler on the source signal
+	struct Fused
+	{
+		class Chain
+		{
+		public:
+			template < typename Derived_ >
+			Derived_ operator() (Derived_ d) { return d; }
+		};
+
+		static std::string GetName() { return "wigwag_fused"; }
+	};
+
+
+	// Every stage is connected to its own intermediate signal, and the next stage is connected to that signal
+	struct Chained
+	{
+		class Chain
+		{
+			template < typename Signature_ >
+			struct Node;
+
+			template < typename... ArgTypes_ >
+			struct Node<void(ArgTypes_...)>
+			{
+				wigwag::signal<void(ArgTypes_...)>	s;
+				token								t;
+
+				template < typename Derived_ >
+				explicit Node(const Derived_& d)
+					: s(), t()
+				{ t = d.connect([this](ArgTypes_... args) { s(args...); }); }
+			};
+
+		private:
+			std::vector<std::shared_ptr<void>>	_nodes;
+
+		public:
+			Chain() : _nodes() { }
+
+			~Chain()
+			{
+				while (!_nodes.empty())
+					_nodes.pop_back();
+			}
+
+			template < typename Derived_ >
+			auto operator() (const Derived_& d) -> decltype(derive(std::declval<signal_connector<typename Derived_::signature>>()))
+			{
+				std::shared_ptr<Node<typename Derived_::signature>> node = std::make_shared<Node<typename Derived_::signature>>(d);
+				_nodes.push_back(node);
+				return derive(node->s);
+			}
+		};
+
+		static std::string GetName() { return "wigwag_chained"; }
+	};
+
+}}}
+
+#endif
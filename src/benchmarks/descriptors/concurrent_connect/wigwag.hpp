@@ -0,0 +1,43 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_CONCURRENT_CONNECT_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_CONCURRENT_CONNECT_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+
+#include <string>
+
+
+namespace descriptors {
+namespace concurrent_connect {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct LockFree
+	{
+		using SignalType = wigwag::signal<void()>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static signal_attributes MakeSignal() { return signal_attributes::none; }
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_lock_free"; }
+	};
+
+
+	// A populator makes the connect take the lock
+	struct Locked
+	{
+		using SignalType = wigwag::signal<void(), state_populating::populator_only>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static std::function<void(const HandlerType&)> MakeSignal() { return [](const HandlerType&) { }; }
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_locked"; }
+	};
+
+}}}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_EXECUTOR_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_EXECUTOR_WIGWAG_HPP
+
+
+#include <wigwag/thread_task_executor.hpp>
+
+#include <memory>
+
+
+namespace descriptors {
+namespace executor {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	static const std::size_t QueueCapacity = 1024;
+
+
+	struct Unbounded
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::unbounded>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType); }
+		static std::string GetName() { return "wigwag_unbounded"; }
+	};
+
+
+	struct UnboundedInstrumented
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::unbounded, instrumentation::histograms>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType); }
+		static std::string GetName() { return "wigwag_unbounded_instrumented"; }
+	};
+
+
+	struct BlockProducer
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::block_producer>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType(task_queue::args(QueueCapacity))); }
+		static std::string GetName() { return "wigwag_block_producer"; }
+	};
+
+
+	struct DropOldest
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::drop_oldest>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType(task_queue::args(QueueCapacity))); }
+		static std::string GetName() { return "wigwag_drop_oldest"; }
+	};
+
+
+	struct DropNewest
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::drop_newest>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType(task_queue::args(QueueCapacity))); }
+		static std::string GetName() { return "wigwag_drop_newest"; }
+	};
+
+
+	struct Coalesce
+	{
+		using ExecutorType = basic_thread_task_executor<task_queue::coalesce>;
+
+		static std::unique_ptr<ExecutorType> MakeExecutor() { return std::unique_ptr<ExecutorType>(new ExecutorType(task_queue::args(QueueCapacity))); }
+		static std::string GetName() { return "wigwag_coalesce"; }
+	};
+
+}}}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef BENCHMARKS_DESCRIPTORS_GENERIC_BOOST_HPP
 #define BENCHMARKS_DESCRIPTORS_GENERIC_BOOST_HPP
 
+#if WIGWAG_BENCHMARKS_BOOST
 
 #include <boost/thread/condition_variable.hpp>
 
@@ -22,3 +23,5 @@ namespace boost
 }}}
 
 #endif
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef BENCHMARKS_DESCRIPTORS_THREADING_BOOST_HPP
 #define BENCHMARKS_DESCRIPTORS_THREADING_BOOST_HPP
 
+#if WIGWAG_BENCHMARKS_BOOST
 
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
@@ -30,3 +31,5 @@ namespace boost
 }}}
 
 #endif
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_EXAMPLES_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_EXAMPLES_HPP
+
+
+#include "../../../../examples/observable_dictionary/SortedObservableDictionary.hpp"
+
+#include <memory>
+#include <vector>
+
+
+namespace descriptors {
+namespace observable {
+namespace examples
+{
+
+	struct SortedDictionaryCollection : public SortedObservableDictionary<int64_t, int64_t>
+	{
+		SortedDictionaryCollection(int64_t size)
+		{
+			for (int64_t i = 0; i < size; ++i)
+				Set(i, 0);
+		}
+	};
+
+	// Handles whole change sets, so a listener gets a single call per batch
+	template < typename Handler_ >
+	class ChangeSetListener : public IObservableDictionaryListener<int64_t, int64_t>
+	{
+	private:
+		Handler_	_handler;
+
+	public:
+		ChangeSetListener(const Handler_& handler) : _handler(handler) { }
+
+		virtual void OnItemAdded(const int64_t&, const int64_t&) { }
+		virtual void OnItemRemoved(const int64_t&, const int64_t&) { }
+		virtual void OnItemUpdated(const int64_t&, const int64_t&) { }
+
+		virtual void OnChanged(const ::std::vector<ObservableDictionaryChange<int64_t, int64_t>>& changes)
+		{ _handler((int64_t)changes.size()); }
+	};
+
+	struct SortedDictionary
+	{
+		using CollectionType = SortedDictionaryCollection;
+		using ConnectionType = ::wigwag::token;
+		using SnapshotType = ::std::vector<ObservableDictionaryChange<int64_t, int64_t>>;
+
+		template < typename Handler_ >
+		static ConnectionType Connect(const CollectionType& c, const Handler_& handler)
+		{ return c.AddListener(::std::make_shared<ChangeSetListener<Handler_>>(handler)); }
+
+		// The dictionary may be read as a whole only by a populator
+		static SnapshotType GetSnapshot(const CollectionType& c)
+		{
+			SnapshotType result;
+			c.OnChangeSet().connect([&](const SnapshotType& s) { result = s; });
+			return result;
+		}
+
+		static void Update(CollectionType& c, int64_t key, int64_t value) { c.Set(key, value); }
+
+		static void BeginUpdate(CollectionType& c) { c.BeginUpdate(); }
+		static void EndUpdate(CollectionType& c) { c.EndUpdate(); }
+
+		static ::std::string GetName() { return "examples_sorted_dictionary"; }
+	};
+
+}}}
+
+#endif
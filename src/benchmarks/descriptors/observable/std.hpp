@@ -0,0 +1,69 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_STD_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_STD_HPP
+
+
+#include <wigwag/signal.hpp>
+
+#include <mutex>
+#include <vector>
+
+
+namespace descriptors {
+namespace observable {
+namespace std
+{
+
+	// The usual hand-written observable: a mutex-protected std::vector, a signal with the changed index, and a populator
+	// and snapshots that copy the whole vector
+	class CopyingVectorCollection
+	{
+		using Handler = ::std::function<void(const ::std::vector<int64_t>&, int64_t)>;
+
+	private:
+		::std::vector<int64_t>						_state;
+		::wigwag::signal<void(const ::std::vector<int64_t>&, int64_t)>	_onChanged;
+
+	public:
+		CopyingVectorCollection(int64_t size)
+			: _state(size), _onChanged([this](const Handler& h) { ::std::vector<int64_t> copy(_state); h(copy, -1); })
+		{ }
+
+		template < typename Handler_ >
+		::wigwag::token Connect(const Handler_& handler) const
+		{ return _onChanged.connect([handler](const ::std::vector<int64_t>& s, int64_t index) { handler(index < 0 ? (int64_t)s.size() : 1); }); }
+
+		::std::vector<int64_t> GetSnapshot() const
+		{
+			::std::lock_guard<::std::recursive_mutex> l(_onChanged.lock_primitive());
+			return _state;
+		}
+
+		void Set(int64_t index, int64_t value)
+		{
+			::std::lock_guard<::std::recursive_mutex> l(_onChanged.lock_primitive());
+			_state[index] = value;
+			_onChanged(_state, index);
+		}
+	};
+
+	struct CopyingVector
+	{
+		using CollectionType = CopyingVectorCollection;
+		using ConnectionType = ::wigwag::token;
+		using SnapshotType = ::std::vector<int64_t>;
+
+		template < typename Handler_ >
+		static ConnectionType Connect(const CollectionType& c, const Handler_& handler) { return c.Connect(handler); }
+		static SnapshotType GetSnapshot(const CollectionType& c) { return c.GetSnapshot(); }
+		static void Update(CollectionType& c, int64_t key, int64_t value) { c.Set(key, value); }
+
+		// No batches, every update is reported separately
+		static void BeginUpdate(CollectionType&) { }
+		static void EndUpdate(CollectionType&) { }
+
+		static ::std::string GetName() { return "std_copying_vector"; }
+	};
+
+}}}
+
+#endif
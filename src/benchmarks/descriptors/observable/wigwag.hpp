@@ -0,0 +1,90 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_OBSERVABLE_WIGWAG_HPP
+
+
+#include <wigwag/observable/observable_map.hpp>
+#include <wigwag/observable/observable_unordered_map.hpp>
+#include <wigwag/observable/observable_vector.hpp>
+
+#include <vector>
+
+
+namespace descriptors {
+namespace observable {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+	using namespace ::wigwag::observable;
+
+	// The handlers only look at the size of the change set, so the numbers show the cost of the container and the signal
+	template < typename Collection_ >
+	struct ObservableBase
+	{
+		using ConnectionType = token;
+		using SnapshotType = typename Collection_::snapshot_type;
+
+		template < typename Handler_ >
+		static token Connect(const Collection_& c, const Handler_& handler)
+		{ return c.connect([handler](const typename Collection_::change_set_type& cs) { handler((int64_t)cs.get_changes().size()); }); }
+
+		static SnapshotType GetSnapshot(const Collection_& c)
+		{ return c.get_snapshot(); }
+
+		static void BeginUpdate(Collection_& c) { c.begin_update(); }
+		static void EndUpdate(Collection_& c) { c.end_update(); }
+	};
+
+
+	struct VectorCollection : public observable_vector<int64_t>
+	{
+		VectorCollection(int64_t size)
+		{
+			::std::vector<int64_t> v(size);
+			assign(v.begin(), v.end());
+		}
+	};
+
+	struct Vector : public ObservableBase<VectorCollection>
+	{
+		using CollectionType = VectorCollection;
+
+		static void Update(CollectionType& c, int64_t key, int64_t value) { c.set(key, value); }
+
+		static ::std::string GetName() { return "wigwag_vector"; }
+	};
+
+
+	template < typename Map_ >
+	struct MapCollection : public Map_
+	{
+		MapCollection(int64_t size)
+		{
+			::std::vector<::std::pair<int64_t, int64_t>> v;
+			for (int64_t i = 0; i < size; ++i)
+				v.emplace_back(i, 0);
+			this->insert(v.begin(), v.end());
+		}
+	};
+
+	struct Map : public ObservableBase<MapCollection<observable_map<int64_t, int64_t>>>
+	{
+		using CollectionType = MapCollection<observable_map<int64_t, int64_t>>;
+
+		static void Update(CollectionType& c, int64_t key, int64_t value) { c.set(key, value); }
+
+		static ::std::string GetName() { return "wigwag_map"; }
+	};
+
+	struct UnorderedMap : public ObservableBase<MapCollection<observable_unordered_map<int64_t, int64_t>>>
+	{
+		using CollectionType = MapCollection<observable_unordered_map<int64_t, int64_t>>;
+
+		static void Update(CollectionType& c, int64_t key, int64_t value) { c.set(key, value); }
+
+		static ::std::string GetName() { return "wigwag_unordered_map"; }
+	};
+
+}}}
+
+#endif
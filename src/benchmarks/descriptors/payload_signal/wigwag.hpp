@@ -0,0 +1,42 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_PAYLOAD_SIGNAL_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_PAYLOAD_SIGNAL_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+
+
+namespace descriptors {
+namespace payload_signal {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct Regular
+	{
+		template < typename Signature_ >
+		using SignalType = wigwag::signal<Signature_>;
+		using ConnectionType = token;
+
+		template < typename Signal_, typename Arg_ >
+		static void Invoke(const Signal_& s, Arg_&& arg) { s(std::forward<Arg_>(arg)); }
+
+		static std::string GetName() { return "wigwag"; }
+	};
+
+
+	struct EmitMove
+	{
+		template < typename Signature_ >
+		using SignalType = wigwag::signal<Signature_>;
+		using ConnectionType = token;
+
+		template < typename Signal_, typename Arg_ >
+		static void Invoke(const Signal_& s, Arg_&& arg) { s.emit_move(std::forward<Arg_>(arg)); }
+
+		static std::string GetName() { return "wigwag_emit_move"; }
+	};
+
+}}}
+
+#endif
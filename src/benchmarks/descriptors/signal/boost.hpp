@@ -1,6 +1,7 @@
 #ifndef SRC_BENCHMARKS_DESCRIPTORS_SIGNALS_BOOST_HPP
 #define SRC_BENCHMARKS_DESCRIPTORS_SIGNALS_BOOST_HPP
 
+#if WIGWAG_BENCHMARKS_BOOST
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
@@ -70,5 +71,6 @@ namespace boost
 
 }}}
 
+#endif
 
 #endif
@@ -15,6 +15,9 @@ namespace wigwag
 	template < typename Signature_ >
 	using ui_signal = wigwag::signal<Signature_, exception_handling::none, threading::none, state_populating::none, life_assurance::none, creation::lazy, ref_counter::single_threaded>;
 
+	template < typename Signature_ >
+	using ui_embedded_signal = wigwag::signal<Signature_, exception_handling::none, threading::none, state_populating::none, life_assurance::none, creation::embedded, ref_counter::single_threaded>;
+
 
 	struct Regular
 	{
@@ -27,6 +30,28 @@ namespace wigwag
 	};
 
 
+	struct Sampling
+	{
+		using SignalType = wigwag::signal<void(), profiling::sampling>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_sampling"; }
+	};
+
+
+	struct HazardPointers
+	{
+		using SignalType = wigwag::signal<void(), life_assurance::hazard_pointers>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_hazard_pointers"; }
+	};
+
+
 	struct Ui
 	{
 		using SignalType = ui_signal<void()>;
@@ -37,6 +62,17 @@ namespace wigwag
 		static std::string GetName() { return "wigwag_ui"; }
 	};
 
+
+	struct UiEmbedded
+	{
+		using SignalType = ui_embedded_signal<void()>;
+		using HandlerType = std::function<void()>;
+		using ConnectionType = token;
+
+		static HandlerType MakeHandler() { return []{}; }
+		static std::string GetName() { return "wigwag_ui_embedded"; }
+	};
+
 }}}
 
 #endif
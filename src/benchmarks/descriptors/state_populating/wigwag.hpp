@@ -0,0 +1,92 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_STATE_POPULATING_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_STATE_POPULATING_WIGWAG_HPP
+
+
+#include <wigwag/observable/vector_snapshot.hpp>
+#include <wigwag/signal.hpp>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace descriptors {
+namespace state_populating {
+namespace wigwag
+{
+
+	// Both keep the state in a persistent vector, so the only difference is whether the populator walks it under the lock
+	template < typename StatePopulatingPolicy_ >
+	class ObservableBase
+	{
+		using HandlerType = std::function<void(int64_t)>;
+
+	protected:
+		::wigwag::observable::vector_snapshot<int64_t>						_state;
+		::wigwag::signal<void(int64_t), StatePopulatingPolicy_>		_signal;
+
+	public:
+		template < typename Populator_ >
+		ObservableBase(int64_t stateSize, const Populator_& populator)
+			: _state(), _signal(populator)
+		{
+			std::vector<int64_t> v(stateSize);
+			_state = ::wigwag::observable::vector_snapshot<int64_t>(v.begin(), v.end());
+		}
+
+		template < typename Handler_ >
+		::wigwag::token Connect(const Handler_& handler) { return _signal.connect(handler); }
+
+		void Update(int64_t index, int64_t value)
+		{
+			std::lock_guard<std::recursive_mutex> l(_signal.lock_primitive());
+			_state = _state.replaced(index, value);
+			_signal(value);
+		}
+
+	protected:
+		static void Populate(const ::wigwag::observable::vector_snapshot<int64_t>& state, const HandlerType& h)
+		{
+			for (int64_t v : state)
+				h(v);
+		}
+	};
+
+
+	class InLockObservable : public ObservableBase<::wigwag::state_populating::populator_only>
+	{
+	public:
+		InLockObservable(int64_t stateSize)
+			: ObservableBase(stateSize, [this](const std::function<void(int64_t)>& h) { Populate(_state, h); })
+		{ }
+	};
+
+	struct InLock
+	{
+		using ObservableType = InLockObservable;
+		static std::string GetName() { return "wigwag_in_lock"; }
+	};
+
+
+	class SnapshotObservable : public ObservableBase<::wigwag::state_populating::snapshot_populator>
+	{
+	public:
+		SnapshotObservable(int64_t stateSize)
+			: ObservableBase(stateSize, [this]
+				{
+					::wigwag::observable::vector_snapshot<int64_t> state = _state;
+					return [state](const std::function<void(int64_t)>& h) { Populate(state, h); };
+				})
+		{ }
+	};
+
+	struct Snapshot
+	{
+		using ObservableType = SnapshotObservable;
+		static std::string GetName() { return "wigwag_snapshot"; }
+	};
+
+}}}
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef SRC_BENCHMARKS_DESCRIPTORS_STREAM_WIGWAG_HPP
+#define SRC_BENCHMARKS_DESCRIPTORS_STREAM_WIGWAG_HPP
+
+
+#include <wigwag/signal.hpp>
+#include <wigwag/thread_task_executor.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+#if WIGWAG_HAS_COROUTINES
+#	include <coroutine>
+#	include <exception>
+#endif
+
+
+namespace descriptors {
+namespace stream {
+namespace wigwag
+{
+
+	using namespace ::wigwag;
+
+	struct AsyncHandler
+	{
+		using SignalType = wigwag::signal<void(int)>;
+
+		class Consumer
+		{
+			using ExecutorType = basic_thread_task_executor<task_queue::drop_oldest>;
+
+		private:
+			std::shared_ptr<ExecutorType>	_worker;
+			std::atomic<bool>				_done;
+			token							_t;
+
+		public:
+			Consumer(SignalType& s, int64_t capacity, int last)
+				: _worker(std::make_shared<ExecutorType>(task_queue::args(capacity))), _done(false), _t()
+			{ _t = s.connect(_worker, [this, last](int i) { if (i == last) _done = true; }); }
+
+			void Wait()
+			{
+				while (!_done)
+					std::this_thread::yield();
+			}
+
+			std::size_t GetDroppedCount() const { return _worker->get_queue_statistics().get_dropped_count(); }
+		};
+
+		static std::string GetName() { return "wigwag_async_handler"; }
+	};
+
+#if WIGWAG_HAS_COROUTINES
+	struct Stream
+	{
+		using SignalType = wigwag::signal<void(int)>;
+
+		class Consumer
+		{
+			struct Task
+			{
+				struct promise_type
+				{
+					Task get_return_object() { return Task(); }
+					std::suspend_never initial_suspend() noexcept { return {}; }
+					std::suspend_never final_suspend() noexcept { return {}; }
+					void return_void() { }
+					void unhandled_exception() { std::terminate(); }
+				};
+			};
+
+		private:
+			std::shared_ptr<thread_task_executor>	_worker;
+			emission_stream<void(int)>				_stream;
+			std::atomic<bool>						_done;
+
+		public:
+			Consumer(SignalType& s, int64_t capacity, int last)
+				: _worker(std::make_shared<thread_task_executor>()), _stream(s.stream(capacity, stream_overflow::drop_oldest, _worker)), _done(false)
+			{
+				std::promise<void> started;
+				_worker->add_task([&] { Receive(_stream, last, _done); started.set_value(); });
+				started.get_future().wait();
+			}
+
+			void Wait()
+			{
+				while (!_done)
+					std::this_thread::yield();
+			}
+
+			std::size_t GetDroppedCount() const { return _stream.get_dropped_count(); }
+
+		private:
+			static Task Receive(emission_stream<void(int)>& stream, int last, std::atomic<bool>& done)
+			{
+				// GCC 12 miscompiles co_await in a loop condition
+				for (;;)
+				{
+					int i = co_await stream.next();
+					if (i == last)
+						break;
+				}
+				done = true;
+			}
+		};
+
+		static std::string GetName() { return "wigwag_stream"; }
+	};
+#endif
+
+}}}
+
+#endif
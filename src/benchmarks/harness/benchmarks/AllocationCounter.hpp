@@ -0,0 +1,98 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_ALLOCATIONCOUNTER_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_ALLOCATIONCOUNTER_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+namespace benchmarks
+{
+
+    struct AllocationStats
+    {
+        int64_t     Count;
+        int64_t     Bytes;
+    };
+
+
+    // Fed by the global operator new replacements from AllocationHooks.cpp. Every thread counts its own allocations, so the
+    // hooks never contend, and the totals include the allocations made by executor threads
+    class AllocationCounter
+    {
+        struct ThreadCounters
+        {
+            std::atomic<int64_t>    Count;
+            std::atomic<int64_t>    Bytes;
+            ThreadCounters*         Next;
+
+            ThreadCounters() : Count(0), Bytes(0), Next(nullptr) { }
+        };
+
+    public:
+        static bool IsInstalled() { return GetInstalledFlag().load(std::memory_order_relaxed); }
+        static void MarkInstalled() { GetInstalledFlag().store(true, std::memory_order_relaxed); }
+
+        static void SetEnabled(bool enabled) { GetEnabledFlag().store(enabled, std::memory_order_relaxed); }
+
+        static void OnAllocation(std::size_t size)
+        {
+            if (!GetEnabledFlag().load(std::memory_order_relaxed))
+                return;
+
+            ThreadCounters* c = GetThreadCounters();
+            c->Count.store(c->Count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            c->Bytes.store(c->Bytes.load(std::memory_order_relaxed) + (int64_t)size, std::memory_order_relaxed);
+        }
+
+        static AllocationStats GetTotal()
+        {
+            AllocationStats result = { 0, 0 };
+            for (ThreadCounters* c = GetHead().load(std::memory_order_acquire); c; c = c->Next)
+            {
+                result.Count += c->Count.load(std::memory_order_relaxed);
+                result.Bytes += c->Bytes.load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+    private:
+        static std::atomic<bool>& GetInstalledFlag() { static std::atomic<bool> flag(false); return flag; }
+        static std::atomic<bool>& GetEnabledFlag() { static std::atomic<bool> flag(false); return flag; }
+        static std::atomic<ThreadCounters*>& GetHead() { static std::atomic<ThreadCounters*> head(nullptr); return head; }
+
+        // The counters are allocated with malloc to keep operator new out of the hook, and are never freed so that the
+        // allocations of the finished threads are still counted
+        static ThreadCounters* GetThreadCounters()
+        {
+            static thread_local ThreadCounters* counters = nullptr;
+            if (!counters)
+            {
+                void* p = std::malloc(sizeof(ThreadCounters));
+                if (!p)
+                    std::abort();
+                counters = new(p) ThreadCounters;
+
+                ThreadCounters* head = GetHead().load(std::memory_order_relaxed);
+                do
+                    counters->Next = head;
+                while (!GetHead().compare_exchange_weak(head, counters, std::memory_order_release, std::memory_order_relaxed));
+            }
+            return counters;
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,484 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKAPP_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKAPP_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkSuite.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#   include <sched.h>
+#endif
+
+
+namespace benchmarks
+{
+
+    struct MeasurementStatistics
+    {
+        std::string             Name;
+        MeasurementKind         Kind;
+        std::vector<double>     Samples;
+        double                  Min;
+        double                  Max;
+        double                  Mean;
+        double                  Median;
+        double                  Stddev;
+
+        MeasurementStatistics(std::string name, MeasurementKind kind)
+            : Name(std::move(name)), Kind(kind), Min(0), Max(0), Mean(0), Median(0), Stddev(0)
+        { }
+
+        void Update()
+        {
+            std::vector<double> s(Samples);
+            std::sort(s.begin(), s.end());
+
+            Min = s.front();
+            Max = s.back();
+            Median = (s.size() % 2) ? s[s.size() / 2] : (s[s.size() / 2 - 1] + s[s.size() / 2]) / 2;
+
+            double sum = 0;
+            for (double v : s)
+                sum += v;
+            Mean = sum / s.size();
+
+            double sq = 0;
+            for (double v : s)
+                sq += (v - Mean) * (v - Mean);
+            Stddev = s.size() > 1 ? std::sqrt(sq / (s.size() - 1)) : 0;
+        }
+
+        const char* GetUnit() const
+        {
+            switch (Kind)
+            {
+            case MeasurementKind::Time:     return "ns";
+            case MeasurementKind::Memory:   return "bytes";
+            default:                        return "events";
+            }
+        }
+    };
+
+
+    struct BenchmarkResult
+    {
+        std::string                                         Name;
+        std::vector<std::pair<std::string, int64_t>>        Params;
+        int64_t                                             Iterations;
+        std::vector<MeasurementStatistics>                  Measurements;
+
+        // The same format as the placeholders in benchmarks/github_wiki.md: signal.invoke.wigwag(numSlots:1)
+        std::string GetId() const
+        {
+            if (Params.empty())
+                return Name;
+            std::stringstream ss;
+            ss << Name << "(";
+            for (std::size_t i = 0; i < Params.size(); ++i)
+                ss << (i ? "," : "") << Params[i].first << ":" << Params[i].second;
+            ss << ")";
+            return ss.str();
+        }
+    };
+
+
+    class BenchmarkApp
+    {
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        const BenchmarkSuite&                           _suite;
+        std::vector<std::string>                        _filters;
+        std::map<std::string, std::vector<int64_t>>     _params;
+        int64_t                                         _repetitions;
+        int64_t                                         _iterations;
+        int64_t                                         _maxIterations;
+        double                                          _minTime;
+        int                                             _cpu;
+        std::string                                     _jsonFile;
+        bool                                            _list;
+        bool                                            _usePerfCounters;
+        bool                                            _countAllocations;
+        std::unique_ptr<PerfCounters>                   _perfCounters;
+
+    public:
+        explicit BenchmarkApp(const BenchmarkSuite& suite)
+            : _suite(suite), _repetitions(5), _iterations(0), _maxIterations(100000000), _minTime(0.1), _cpu(-1), _list(false), _usePerfCounters(false), _countAllocations(false)
+        { }
+
+        int Run(int argc, char* argv[])
+        {
+            try
+            { ParseArguments(argc, argv); }
+            catch (const std::exception& ex)
+            {
+                std::cerr << ex.what() << "\n\n";
+                PrintUsage(std::cerr, argv[0]);
+                return 1;
+            }
+
+            if (_list)
+            {
+                for (const auto& e : _suite.GetEntries())
+                    if (Matches(e))
+                        std::cout << e.GetName() << FormatParamNames(e.Info.ParamNames) << std::endl;
+                return 0;
+            }
+
+            if (_usePerfCounters)
+            {
+                _perfCounters.reset(new PerfCounters);
+                if (!_perfCounters->IsAvailable())
+                {
+                    std::cerr << "Hardware counters are not available, measuring time only: " << _perfCounters->GetError() << std::endl;
+                    _perfCounters.reset();
+                }
+            }
+
+            if (_countAllocations)
+            {
+                if (!AllocationCounter::IsInstalled())
+                {
+                    std::cerr << "Allocation counting needs AllocationHooks.cpp to be linked into the benchmarks" << std::endl;
+                    return 1;
+                }
+                AllocationCounter::SetEnabled(true);
+            }
+
+            if (_cpu >= 0 && !PinToCpu(_cpu))
+            {
+                std::cerr << "Could not pin the benchmarks to CPU " << _cpu << std::endl;
+                return 1;
+            }
+
+            std::ostream& log = (_jsonFile == "-") ? std::cerr : std::cout;
+            std::vector<BenchmarkResult> results;
+            for (const auto& e : _suite.GetEntries())
+            {
+                if (!Matches(e))
+                    continue;
+
+                for (const auto& params : GetParamCombinations(e.Info.ParamNames))
+                {
+                    results.push_back(RunBenchmark(e, params));
+                    PrintResult(log, results.back());
+                }
+            }
+
+            if (_jsonFile == "-")
+                WriteJson(std::cout, results);
+            else if (!_jsonFile.empty())
+            {
+                std::ofstream f(_jsonFile.c_str());
+                WriteJson(f, results);
+                if (!f)
+                {
+                    std::cerr << "Could not write " << _jsonFile << std::endl;
+                    return 1;
+                }
+            }
+
+            return 0;
+        }
+
+    private:
+        static void PrintUsage(std::ostream& os, const char* app)
+        {
+            os << "Usage: " << app << " [options]\n"
+                "  -l, --list                 list the benchmarks and their parameters\n"
+                "  -b, --benchmark <glob>     run the benchmarks whose name (class.benchmark.object) matches, may be repeated\n"
+                "  -p, --param <name:v1,v2>   parameter values, every combination is run (default: 1)\n"
+                "  -r, --repetitions <n>      number of measured runs of each benchmark (default: 5)\n"
+                "  -i, --iterations <n>       fixed iterations count instead of the calibrated one\n"
+                "  -t, --min-time <seconds>   minimal duration of a run used for the calibration (default: 0.1)\n"
+                "  -c, --cpu <n>              pin the process to a CPU (threads created by the benchmarks inherit it)\n"
+                "  -j, --json <file>          write the results as JSON, '-' for stdout\n"
+                "  -P, --perf-counters        also measure cycles, instructions, cache and branch misses per operation (Linux)\n"
+                "  -A, --allocations          also count allocations and allocated bytes per operation, on all threads\n";
+        }
+
+        void ParseArguments(int argc, char* argv[])
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                std::string arg = argv[i];
+                auto value = [&]() -> std::string
+                {
+                    if (i + 1 >= argc)
+                        throw std::invalid_argument("Missing value for " + arg);
+                    return argv[++i];
+                };
+
+                if (arg == "-l" || arg == "--list")
+                    _list = true;
+                else if (arg == "-b" || arg == "--benchmark")
+                    _filters.push_back(value());
+                else if (arg == "-p" || arg == "--param")
+                    ParseParam(value());
+                else if (arg == "-r" || arg == "--repetitions")
+                    _repetitions = ParsePositive(arg, value());
+                else if (arg == "-i" || arg == "--iterations")
+                    _iterations = ParsePositive(arg, value());
+                else if (arg == "-t" || arg == "--min-time")
+                    _minTime = std::atof(value().c_str());
+                else if (arg == "-c" || arg == "--cpu")
+                    _cpu = (int)ParseInteger(arg, value());
+                else if (arg == "-j" || arg == "--json")
+                    _jsonFile = value();
+                else if (arg == "-P" || arg == "--perf-counters")
+                    _usePerfCounters = true;
+                else if (arg == "-A" || arg == "--allocations")
+                    _countAllocations = true;
+                else
+                    throw std::invalid_argument("Unknown argument: " + arg);
+            }
+        }
+
+        void ParseParam(const std::string& s)
+        {
+            std::size_t colon = s.find(':');
+            if (colon == std::string::npos || colon == 0)
+                throw std::invalid_argument("Invalid parameter specification: " + s);
+
+            std::vector<int64_t>& values = _params[s.substr(0, colon)];
+            values.clear();
+            std::stringstream ss(s.substr(colon + 1));
+            for (std::string v; std::getline(ss, v, ','); )
+                values.push_back(ParseInteger(s, v));
+            if (values.empty())
+                throw std::invalid_argument("No values in parameter specification: " + s);
+        }
+
+        static int64_t ParseInteger(const std::string& what, const std::string& s)
+        {
+            char* end = nullptr;
+            long long v = std::strtoll(s.c_str(), &end, 10);
+            if (s.empty() || *end != '\0')
+                throw std::invalid_argument("Invalid integer for " + what + ": " + s);
+            return (int64_t)v;
+        }
+
+        static int64_t ParsePositive(const std::string& what, const std::string& s)
+        {
+            int64_t v = ParseInteger(what, s);
+            if (v <= 0)
+                throw std::invalid_argument(what + " must be positive");
+            return v;
+        }
+
+        static bool GlobMatch(const char* pattern, const char* s)
+        {
+            if (*pattern == '*')
+                return GlobMatch(pattern + 1, s) || (*s && GlobMatch(pattern, s + 1));
+            if (!*pattern)
+                return !*s;
+            return *s && (*pattern == '?' || *pattern == *s) && GlobMatch(pattern + 1, s + 1);
+        }
+
+        bool Matches(const BenchmarkEntry& e) const
+        {
+            if (_filters.empty())
+                return true;
+            std::string name = e.GetName();
+            for (const auto& f : _filters)
+                if (GlobMatch(f.c_str(), name.c_str()))
+                    return true;
+            return false;
+        }
+
+        static std::string FormatParamNames(const std::vector<std::string>& names)
+        {
+            std::string result;
+            for (std::size_t i = 0; i < names.size(); ++i)
+                result += (i ? "," : "(") + names[i];
+            return names.empty() ? result : result + ")";
+        }
+
+        std::vector<std::vector<int64_t>> GetParamCombinations(const std::vector<std::string>& names) const
+        {
+            std::vector<std::vector<int64_t>> result(1);
+            for (const auto& name : names)
+            {
+                auto it = _params.find(name);
+                std::vector<int64_t> values = (it != _params.end()) ? it->second : std::vector<int64_t>(1, 1);
+
+                std::vector<std::vector<int64_t>> next;
+                for (const auto& prefix : result)
+                    for (int64_t v : values)
+                    {
+                        next.push_back(prefix);
+                        next.back().push_back(v);
+                    }
+                result.swap(next);
+            }
+            return result;
+        }
+
+        double RunOnce(const BenchmarkEntry& e, const std::vector<int64_t>& params, int64_t iterations, std::vector<Measurement>& measurements) const
+        {
+            Clock::time_point start = Clock::now();
+            BenchmarkContext context(iterations, _perfCounters.get(), _countAllocations);
+            e.Info.Func(context, params);
+            measurements = context.GetMeasurements();
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        // Grows the iterations count until a run takes at least _minTime, the runs also serve as a warm-up
+        int64_t Calibrate(const BenchmarkEntry& e, const std::vector<int64_t>& params) const
+        {
+            std::vector<Measurement> measurements;
+            int64_t n = 1;
+            while (true)
+            {
+                double t = RunOnce(e, params, n, measurements);
+                if (t >= _minTime || n >= _maxIterations)
+                    return n;
+
+                double factor = (t > _minTime / 10) ? _minTime * 1.2 / t : 10;
+                n = std::min(_maxIterations, (int64_t)std::ceil(n * factor));
+            }
+        }
+
+        BenchmarkResult RunBenchmark(const BenchmarkEntry& e, const std::vector<int64_t>& params) const
+        {
+            BenchmarkResult result;
+            result.Name = e.GetName();
+            for (std::size_t i = 0; i < params.size(); ++i)
+                result.Params.push_back(std::make_pair(e.Info.ParamNames[i], params[i]));
+            result.Iterations = (_iterations > 0) ? _iterations : Calibrate(e, params);
+
+            for (int64_t r = 0; r < _repetitions; ++r)
+            {
+                std::vector<Measurement> measurements;
+                RunOnce(e, params, result.Iterations, measurements);
+
+                for (const auto& m : measurements)
+                {
+                    auto it = std::find_if(result.Measurements.begin(), result.Measurements.end(),
+                        [&](const MeasurementStatistics& s) { return s.Name == m.Name && s.Kind == m.Kind; });
+                    if (it == result.Measurements.end())
+                        it = result.Measurements.insert(result.Measurements.end(), MeasurementStatistics(m.Name, m.Kind));
+                    it->Samples.push_back(m.Value);
+                }
+            }
+
+            for (auto& m : result.Measurements)
+                m.Update();
+
+            return result;
+        }
+
+        static void PrintResult(std::ostream& os, const BenchmarkResult& r)
+        {
+            std::string id = r.GetId();
+            for (const auto& m : r.Measurements)
+            {
+                if (m.Kind == MeasurementKind::Counter)
+                    continue;
+
+                os << id << "[" << m.Name << "]: " << std::setprecision(4) << m.Median << " " << m.GetUnit();
+                if (m.Samples.size() > 1)
+                    os << " (median of " << m.Samples.size() << ", mean " << m.Mean << ", stddev " << m.Stddev << ", min " << m.Min << ", max " << m.Max << ")";
+
+                std::string prefix = m.Name + ".";
+                for (const auto& c : r.Measurements)
+                    if (c.Kind == MeasurementKind::Counter && c.Name.compare(0, prefix.size(), prefix) == 0)
+                        os << ", " << c.Name.substr(prefix.size()) << " " << c.Median;
+                os << std::endl;
+            }
+        }
+
+        static void WriteJsonString(std::ostream& os, const std::string& s)
+        {
+            os << '"';
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                    os << '\\';
+                os << c;
+            }
+            os << '"';
+        }
+
+        void WriteJson(std::ostream& os, const std::vector<BenchmarkResult>& results) const
+        {
+            char date[32] = "";
+            std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            os << std::setprecision(9);
+            os << "{\n  \"context\": {\"date\": \"" << date << "\", \"num_cpus\": " << std::thread::hardware_concurrency()
+                << ", \"cpu\": " << _cpu << ", \"repetitions\": " << _repetitions << ", \"min_time\": " << _minTime << "},\n";
+            os << "  \"benchmarks\": [";
+            for (std::size_t i = 0; i < results.size(); ++i)
+            {
+                const BenchmarkResult& r = results[i];
+                os << (i ? ",\n" : "\n") << "    {\"id\": ";
+                WriteJsonString(os, r.GetId());
+                os << ", \"name\": ";
+                WriteJsonString(os, r.Name);
+                os << ", \"params\": {";
+                for (std::size_t j = 0; j < r.Params.size(); ++j)
+                {
+                    os << (j ? ", " : "");
+                    WriteJsonString(os, r.Params[j].first);
+                    os << ": " << r.Params[j].second;
+                }
+                os << "}, \"iterations\": " << r.Iterations << ", \"measurements\": [";
+                for (std::size_t j = 0; j < r.Measurements.size(); ++j)
+                {
+                    const MeasurementStatistics& m = r.Measurements[j];
+                    os << (j ? "," : "") << "\n      {\"name\": ";
+                    WriteJsonString(os, m.Name);
+                    os << ", \"unit\": \"" << m.GetUnit() << "\", \"median\": " << m.Median << ", \"mean\": " << m.Mean
+                        << ", \"stddev\": " << m.Stddev << ", \"min\": " << m.Min << ", \"max\": " << m.Max << ", \"samples\": [";
+                    for (std::size_t k = 0; k < m.Samples.size(); ++k)
+                        os << (k ? ", " : "") << m.Samples[k];
+                    os << "]}";
+                }
+                os << "]}";
+            }
+            os << "\n  ]\n}\n";
+        }
+
+        static bool PinToCpu(int cpu)
+        {
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+            (void)cpu;
+            return false;
+#endif
+        }
+    };
+
+}
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKCLASS_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKCLASS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkContext.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    struct BenchmarkInfo
+    {
+        using Function = std::function<void(BenchmarkContext&, const std::vector<int64_t>&)>;
+
+        std::string                 Name;
+        std::vector<std::string>    ParamNames;
+        Function                    Func;
+    };
+
+
+    class BenchmarksClass
+    {
+        template < std::size_t... Indices_ > struct IndexSequence { };
+
+        template < std::size_t N_, std::size_t... Indices_ >
+        struct MakeIndexSequence : MakeIndexSequence<N_ - 1, N_ - 1, Indices_...> { };
+
+        template < std::size_t... Indices_ >
+        struct MakeIndexSequence<0, Indices_...> { using Type = IndexSequence<Indices_...>; };
+
+    private:
+        std::string                 _name;
+        std::vector<BenchmarkInfo>  _benchmarks;
+
+    public:
+        explicit BenchmarksClass(std::string name)
+            : _name(std::move(name))
+        { }
+
+        const std::string& GetName() const { return _name; }
+        const std::vector<BenchmarkInfo>& GetBenchmarks() const { return _benchmarks; }
+
+    protected:
+        template < typename... Params_ >
+        void AddBenchmark(std::string name, void (*func)(BenchmarkContext&, Params_...), std::vector<std::string> paramNames = std::vector<std::string>())
+        {
+            if (paramNames.size() != sizeof...(Params_))
+                throw std::logic_error("Invalid number of parameter names for benchmark " + _name + "." + name);
+
+            BenchmarkInfo b = { std::move(name), std::move(paramNames), BenchmarkInfo::Function() };
+            b.Func = [func](BenchmarkContext& context, const std::vector<int64_t>& params)
+                { Invoke(func, context, params, typename MakeIndexSequence<sizeof...(Params_)>::Type()); };
+            _benchmarks.push_back(std::move(b));
+        }
+
+    private:
+        template < typename... Params_, std::size_t... Indices_ >
+        static void Invoke(void (*func)(BenchmarkContext&, Params_...), BenchmarkContext& context, const std::vector<int64_t>& params, IndexSequence<Indices_...>)
+        { func(context, static_cast<Params_>(params[Indices_])...); }
+    };
+
+}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKCONTEXT_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKCONTEXT_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/AllocationCounter.hpp>
+#include <benchmarks/PerfCounters.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__)
+#   include <malloc.h>
+#endif
+
+
+namespace benchmarks
+{
+
+    enum class MeasurementKind { Time, Memory, Counter };
+
+
+    struct Measurement
+    {
+        std::string         Name;
+        MeasurementKind     Kind;
+        double              Value; // ns or events per operation, bytes per object
+    };
+
+
+    class BenchmarkContext;
+
+    class OperationProfiler
+    {
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        BenchmarkContext*   _context;
+        std::string         _name;
+        int64_t             _count;
+        AllocationStats     _startAllocations;
+        Clock::time_point   _start;
+
+    public:
+        inline OperationProfiler(BenchmarkContext& context, std::string name, int64_t count);
+
+        OperationProfiler(OperationProfiler&& other)
+            : _context(other._context), _name(std::move(other._name)), _count(other._count), _startAllocations(other._startAllocations), _start(other._start)
+        { other._context = nullptr; }
+
+        OperationProfiler(const OperationProfiler&) = delete;
+        OperationProfiler& operator = (const OperationProfiler&) = delete;
+
+        inline ~OperationProfiler();
+    };
+
+
+    class BenchmarkContext
+    {
+        friend class OperationProfiler;
+
+    private:
+        int64_t                     _iterationsCount;
+        int64_t                     _allocatedAtStart;
+        PerfCounters*               _perfCounters;
+        bool                        _countAllocations;
+        std::vector<Measurement>    _measurements;
+
+    public:
+        explicit BenchmarkContext(int64_t iterationsCount, PerfCounters* perfCounters = nullptr, bool countAllocations = false)
+            : _iterationsCount(iterationsCount), _allocatedAtStart(GetAllocatedBytes()), _perfCounters(perfCounters), _countAllocations(countAllocations)
+        { }
+
+        int64_t GetIterationsCount() const { return _iterationsCount; }
+        const std::vector<Measurement>& GetMeasurements() const { return _measurements; }
+
+        OperationProfiler Profile(std::string name, int64_t count)
+        { return OperationProfiler(*this, std::move(name), count); }
+
+        template < typename Func_ >
+        void Profile(std::string name, int64_t count, const Func_& f)
+        {
+            OperationProfiler op(*this, std::move(name), count);
+            f();
+        }
+
+        // For the values a benchmark computes itself, like latency percentiles
+        void ReportTime(std::string name, double ns)
+        {
+            Measurement m = { std::move(name), MeasurementKind::Time, ns };
+            _measurements.push_back(std::move(m));
+        }
+
+        // Printed next to the measurement whose name is the prefix of the counter name, e.g. "deliver.dropped"
+        void ReportCounter(std::string name, double value)
+        {
+            Measurement m = { std::move(name), MeasurementKind::Counter, value };
+            _measurements.push_back(std::move(m));
+        }
+
+        // Memory allocated since the context creation divided by the number of objects. Not available without glibc
+        void MeasureMemory(std::string name, int64_t count)
+        {
+            int64_t allocated = GetAllocatedBytes();
+            if (allocated < 0)
+                return;
+            Measurement m = { std::move(name), MeasurementKind::Memory, double(allocated - _allocatedAtStart) / double(count) };
+            _measurements.push_back(std::move(m));
+        }
+
+    private:
+        static int64_t GetAllocatedBytes()
+        {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+            return (int64_t)mallinfo2().uordblks;
+#elif defined(__GLIBC__)
+            return (int64_t)(unsigned)mallinfo().uordblks;
+#else
+            return -1;
+#endif
+        }
+    };
+
+
+    OperationProfiler::OperationProfiler(BenchmarkContext& context, std::string name, int64_t count)
+        : _context(&context), _name(std::move(name)), _count(count), _startAllocations(AllocationCounter::GetTotal())
+    {
+        if (_context->_perfCounters)
+            _context->_perfCounters->Start();
+        _start = Clock::now();
+    }
+
+    OperationProfiler::~OperationProfiler()
+    {
+        if (!_context)
+            return;
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - _start).count();
+
+        // Counters are reported as "<operation>.<counter>" events per operation
+        std::vector<Measurement>& measurements = _context->_measurements;
+        if (_context->_perfCounters)
+        {
+            std::vector<double> counters = _context->_perfCounters->Stop();
+            const std::vector<std::string>& names = _context->_perfCounters->GetNames();
+            for (std::size_t i = 0; i < counters.size(); ++i)
+            {
+                Measurement c = { _name + "." + names[i], MeasurementKind::Counter, counters[i] / double(_count) };
+                measurements.push_back(std::move(c));
+            }
+        }
+
+        if (_context->_countAllocations)
+        {
+            AllocationStats allocations = AllocationCounter::GetTotal();
+            Measurement count = { _name + ".allocs", MeasurementKind::Counter, double(allocations.Count - _startAllocations.Count) / double(_count) };
+            Measurement bytes = { _name + ".allocBytes", MeasurementKind::Counter, double(allocations.Bytes - _startAllocations.Bytes) / double(_count) };
+            measurements.push_back(std::move(count));
+            measurements.push_back(std::move(bytes));
+        }
+
+        Measurement m = { std::move(_name), MeasurementKind::Time, ns / double(_count) };
+        measurements.push_back(std::move(m));
+    }
+
+}
+
+#endif
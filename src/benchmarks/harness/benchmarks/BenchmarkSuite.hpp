@@ -0,0 +1,63 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKSUITE_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_BENCHMARKSUITE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <benchmarks/BenchmarkClass.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace benchmarks
+{
+
+    struct BenchmarkEntry
+    {
+        std::string     ClassName;
+        std::string     ObjectName;
+        BenchmarkInfo   Info;
+
+        std::string GetName() const { return ClassName + "." + Info.Name + "." + ObjectName; }
+    };
+
+
+    class BenchmarkSuite
+    {
+    private:
+        std::vector<BenchmarkEntry>     _entries;
+
+    public:
+        template < template <typename> class BenchmarksClass_, typename... Descriptors_ >
+        void RegisterBenchmarks()
+        {
+            int dummy[] = { 0, (RegisterBenchmarksClass<BenchmarksClass_<Descriptors_>>(Descriptors_::GetName()), 0)... };
+            (void)dummy;
+        }
+
+        const std::vector<BenchmarkEntry>& GetEntries() const { return _entries; }
+
+    private:
+        template < typename BenchmarksClass_ >
+        void RegisterBenchmarksClass(const std::string& objectName)
+        {
+            BenchmarksClass_ c;
+            for (const auto& b : c.GetBenchmarks())
+            {
+                BenchmarkEntry e = { c.GetName(), objectName, b };
+                _entries.push_back(std::move(e));
+            }
+        }
+    };
+
+}
+
+#endif
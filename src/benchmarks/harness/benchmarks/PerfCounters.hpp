@@ -0,0 +1,130 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_PERFCOUNTERS_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_PERFCOUNTERS_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#   include <cerrno>
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+
+namespace benchmarks
+{
+
+    // Hardware counters of the calling thread, read as one perf_event group so that all of them cover the same code
+    class PerfCounters
+    {
+    private:
+        std::vector<std::string>    _names;
+        std::vector<int>            _fds;
+        std::string                 _error;
+
+    public:
+        PerfCounters()
+        {
+#if defined(__linux__)
+            const uint64_t l1dReadMiss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+            TryOpen("cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            if (_fds.empty())
+                return;
+            TryOpen("instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            TryOpen("l1dMisses", PERF_TYPE_HW_CACHE, l1dReadMiss);
+            TryOpen("llcMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            TryOpen("branchMisses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#else
+            _error = "perf_event_open is available only on Linux";
+#endif
+        }
+
+        ~PerfCounters()
+        {
+#if defined(__linux__)
+            for (int fd : _fds)
+                close(fd);
+#endif
+        }
+
+        PerfCounters(const PerfCounters&) = delete;
+        PerfCounters& operator = (const PerfCounters&) = delete;
+
+        bool IsAvailable() const { return !_fds.empty(); }
+        const std::string& GetError() const { return _error; }
+        const std::vector<std::string>& GetNames() const { return _names; }
+
+        void Start()
+        {
+#if defined(__linux__)
+            ioctl(_fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(_fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+        }
+
+        // Returns the counter values in the GetNames() order, scaled if the kernel had to multiplex the counters
+        std::vector<double> Stop()
+        {
+            std::vector<double> result;
+#if defined(__linux__)
+            ioctl(_fds.front(), PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+            std::vector<uint64_t> buf(3 + _fds.size()); // nr, time_enabled, time_running, values...
+            if (read(_fds.front(), buf.data(), buf.size() * sizeof(uint64_t)) < (ssize_t)(3 * sizeof(uint64_t)))
+                return result;
+
+            double scale = (buf[2] != 0 && buf[2] < buf[1]) ? double(buf[1]) / double(buf[2]) : 1.0;
+            for (std::size_t i = 0; i < _fds.size() && i < buf[0]; ++i)
+                result.push_back(double(buf[3 + i]) * scale);
+#endif
+            return result;
+        }
+
+    private:
+#if defined(__linux__)
+        void TryOpen(const char* name, uint32_t type, uint64_t config)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = _fds.empty() ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            int groupFd = _fds.empty() ? -1 : _fds.front();
+            int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+            if (fd < 0)
+            {
+                if (_fds.empty())
+                    _error = std::string("perf_event_open failed: ") + std::strerror(errno);
+                return;
+            }
+
+            _fds.push_back(fd);
+            _names.push_back(name);
+        }
+#endif
+    };
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef SRC_BENCHMARKS_HARNESS_BENCHMARKS_UTILS_STORAGE_HPP
+#define SRC_BENCHMARKS_HARNESS_BENCHMARKS_UTILS_STORAGE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace benchmarks
+{
+
+    template < typename T_ >
+    class StorageFor
+    {
+    private:
+        typename std::aligned_storage<sizeof(T_), std::alignment_of<T_>::value>::type   _storage;
+        bool                                                                            _constructed;
+
+    public:
+        StorageFor() : _constructed(false) { }
+        ~StorageFor() { Destruct(); }
+
+        StorageFor(const StorageFor&) = delete;
+        StorageFor& operator = (const StorageFor&) = delete;
+
+        template < typename... Args_ >
+        void Construct(Args_&&... args)
+        {
+            Destruct();
+            new(&_storage) T_(std::forward<Args_>(args)...);
+            _constructed = true;
+        }
+
+        void Destruct()
+        {
+            if (!_constructed)
+                return;
+            Ref().~T_();
+            _constructed = false;
+        }
+
+        T_& Ref() { return *reinterpret_cast<T_*>(&_storage); }
+    };
+
+
+    template < typename T_ >
+    class StorageArray
+    {
+    private:
+        std::unique_ptr<StorageFor<T_>[]>   _storage;
+        int64_t                             _size;
+
+    public:
+        explicit StorageArray(int64_t size)
+            : _storage(new StorageFor<T_>[size]), _size(size)
+        { }
+
+        StorageFor<T_>& operator[](int64_t i) { return _storage[i]; }
+
+        void Construct()
+        {
+            for (int64_t i = 0; i < _size; ++i)
+                _storage[i].Construct();
+        }
+
+        template < typename Func_ >
+        void Construct(const Func_& f)
+        {
+            for (int64_t i = 0; i < _size; ++i)
+                _storage[i].Construct(f());
+        }
+
+        void Destruct()
+        {
+            for (int64_t i = 0; i < _size; ++i)
+                _storage[i].Destruct();
+        }
+
+        template < typename Func_ >
+        void ForEach(const Func_& f)
+        {
+            for (int64_t i = 0; i < _size; ++i)
+                f(_storage[i].Ref());
+        }
+    };
+
+}
+
+#endif
@@ -8,12 +8,30 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <benchmarks/AffineSignalBenchmarks.hpp>
+#include <benchmarks/AsyncSignalBenchmarks.hpp>
+#include <benchmarks/AwaitBenchmarks.hpp>
 #include <benchmarks/BenchmarkApp.hpp>
 #include <benchmarks/BenchmarkSuite.hpp>
+#include <benchmarks/CascadeBenchmarks.hpp>
+#include <benchmarks/CombinatorBenchmarks.hpp>
+#include <benchmarks/ConcurrentConnectBenchmarks.hpp>
+#include <benchmarks/ExecutorBenchmarks.hpp>
 #include <benchmarks/FunctionBenchmarks.hpp>
 #include <benchmarks/GenericBenchmarks.hpp>
 #include <benchmarks/MutexBenchmarks.hpp>
+#include <benchmarks/ObservableBenchmarks.hpp>
+#include <benchmarks/PayloadSignalBenchmarks.hpp>
 #include <benchmarks/SignalBenchmarks.hpp>
+#include <benchmarks/descriptors/affine_signal/wigwag.hpp>
+#include <benchmarks/descriptors/async_latency/boost.hpp>
+#include <benchmarks/descriptors/async_latency/wigwag.hpp>
+#include <benchmarks/descriptors/async_signal/wigwag.hpp>
+#include <benchmarks/descriptors/await/wigwag.hpp>
+#include <benchmarks/descriptors/cascade/wigwag.hpp>
+#include <benchmarks/descriptors/combinator/wigwag.hpp>
+#include <benchmarks/descriptors/concurrent_connect/wigwag.hpp>
+#include <benchmarks/descriptors/executor/wigwag.hpp>
 #include <benchmarks/descriptors/function/boost.hpp>
 #include <benchmarks/descriptors/function/std.hpp>
 #include <benchmarks/descriptors/generic/boost.hpp>
@@ -21,10 +39,22 @@
 #include <benchmarks/descriptors/generic/wigwag.hpp>
 #include <benchmarks/descriptors/mutex/boost.hpp>
 #include <benchmarks/descriptors/mutex/std.hpp>
+#include <benchmarks/descriptors/observable/examples.hpp>
+#include <benchmarks/descriptors/observable/std.hpp>
+#include <benchmarks/descriptors/observable/wigwag.hpp>
+#include <benchmarks/descriptors/payload_signal/wigwag.hpp>
 #include <benchmarks/descriptors/signal/boost.hpp>
 #include <benchmarks/descriptors/signal/qt5.hpp>
 #include <benchmarks/descriptors/signal/sigcpp.hpp>
 #include <benchmarks/descriptors/signal/wigwag.hpp>
+#include <benchmarks/descriptors/state_populating/wigwag.hpp>
+#include <benchmarks/descriptors/stream/wigwag.hpp>
+
+#if WIGWAG_BENCHMARKS_STANDALONE
+#include <benchmarks/AsyncLatencyBenchmarks.hpp>
+#include <benchmarks/StatePopulatingBenchmarks.hpp>
+#include <benchmarks/StreamBenchmarks.hpp>
+#endif
 
 #include <iostream>
 
@@ -39,9 +69,14 @@ int main(int argc, char* argv[])
         BenchmarkSuite s;
         s.RegisterBenchmarks<SignalBenchmarks,
             signal::wigwag::Regular,
+            signal::wigwag::Sampling,
+            signal::wigwag::HazardPointers,
             signal::wigwag::Ui,
-            signal::boost::Regular,
-            signal::boost::Tracking
+            signal::wigwag::UiEmbedded
+#if WIGWAG_BENCHMARKS_BOOST
+            , signal::boost::Regular
+            , signal::boost::Tracking
+#endif
 #if WIGWAG_BENCHMARKS_SIGCPP2
             , signal::sigcpp::Regular
 #endif
@@ -50,19 +85,96 @@ int main(int argc, char* argv[])
 #endif
             >();
 
+        s.RegisterBenchmarks<AsyncSignalBenchmarks,
+            async_signal::wigwag::Regular,
+            async_signal::wigwag::Threaded,
+            async_signal::wigwag::ThreadedInline>();
+
+        s.RegisterBenchmarks<AffineSignalBenchmarks,
+            affine_signal::wigwag::PerHandler,
+            affine_signal::wigwag::Affine>();
+
+        s.RegisterBenchmarks<AwaitBenchmarks,
+            await::wigwag::Promise
+#if WIGWAG_HAS_COROUTINES
+            , await::wigwag::Coroutine
+#endif
+            >();
+
+        s.RegisterBenchmarks<CascadeBenchmarks,
+            cascade::wigwag::DepthFirst,
+            cascade::wigwag::Queued>();
+
+        s.RegisterBenchmarks<CombinatorBenchmarks,
+            combinator::wigwag::Fused,
+            combinator::wigwag::Chained>();
+
+        s.RegisterBenchmarks<ConcurrentConnectBenchmarks,
+            concurrent_connect::wigwag::LockFree,
+            concurrent_connect::wigwag::Locked>();
+
+#if WIGWAG_BENCHMARKS_STANDALONE
+        s.RegisterBenchmarks<AsyncLatencyBenchmarks,
+            async_latency::wigwag::Unbounded,
+            async_latency::wigwag::UnboundedInstrumented,
+            async_latency::wigwag::BlockProducer
+#if WIGWAG_BENCHMARKS_BOOST
+            , async_latency::boost::AsioPost
+#endif
+            >();
+
+        s.RegisterBenchmarks<StatePopulatingBenchmarks,
+            state_populating::wigwag::InLock,
+            state_populating::wigwag::Snapshot>();
+
+        s.RegisterBenchmarks<StreamBenchmarks,
+            stream::wigwag::AsyncHandler
+#if WIGWAG_HAS_COROUTINES
+            , stream::wigwag::Stream
+#endif
+            >();
+#endif
+
+        s.RegisterBenchmarks<PayloadSignalBenchmarks,
+            payload_signal::wigwag::Regular,
+            payload_signal::wigwag::EmitMove>();
+
+        s.RegisterBenchmarks<ObservableBenchmarks,
+            observable::wigwag::Vector,
+            observable::wigwag::Map,
+            observable::wigwag::UnorderedMap,
+            observable::std::CopyingVector,
+            observable::examples::SortedDictionary>();
+
+        s.RegisterBenchmarks<ExecutorBenchmarks,
+            executor::wigwag::Unbounded,
+            executor::wigwag::UnboundedInstrumented,
+            executor::wigwag::BlockProducer,
+            executor::wigwag::DropOldest,
+            executor::wigwag::DropNewest,
+            executor::wigwag::Coalesce>();
+
         s.RegisterBenchmarks<FunctionBenchmarks,
-            function::std::Regular,
-            function::boost::Regular>();
+            function::std::Regular
+#if WIGWAG_BENCHMARKS_BOOST
+            , function::boost::Regular
+#endif
+            >();
 
         s.RegisterBenchmarks<MutexBenchmarks,
             mutex::std::Mutex,
-            mutex::std::RecursiveMutex,
-            mutex::boost::Mutex,
-            mutex::boost::RecursiveMutex >();
+            mutex::std::RecursiveMutex
+#if WIGWAG_BENCHMARKS_BOOST
+            , mutex::boost::Mutex
+            , mutex::boost::RecursiveMutex
+#endif
+            >();
 
         s.RegisterBenchmarks<GenericBenchmarks,
             generic::std::ConditionVariable,
+#if WIGWAG_BENCHMARKS_BOOST
             generic::boost::ConditionVariable,
+#endif
             generic::wigwag::LifeToken>();
 
         return BenchmarkApp(s).Run(argc, argv);
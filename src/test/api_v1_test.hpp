@@ -11,19 +11,36 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/affine_signal.hpp>
+#include <wigwag/derived_signal.hpp>
 #include <wigwag/life_token.hpp>
 #include <wigwag/listenable.hpp>
+#include <wigwag/observable/observable_map.hpp>
+#include <wigwag/observable/observable_unordered_map.hpp>
+#include <wigwag/observable/observable_vector.hpp>
 #include <wigwag/signal.hpp>
+#include <wigwag/signal_profiling.hpp>
 #include <wigwag/thread_task_executor.hpp>
 #include <wigwag/threadless_task_executor.hpp>
 #include <wigwag/token_pool.hpp>
+#include <wigwag/tracing.hpp>
 
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <future>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
 #include <thread>
+#include <vector>
 
+#include <test/utils/coroutine.hpp>
 #include <test/utils/mutexed.hpp>
 #include <test/utils/profiler.hpp>
 #include <test/utils/thread.hpp>
@@ -86,6 +103,50 @@ private:
         }
     };
 
+    // Keeps its state on the heap, so that the sanitizers report the handlers invoked through a destroyed implementation
+    class heap_state_exception_handler
+    {
+    private:
+        std::vector<int>    _state;
+
+    public:
+        using tag = exception_handling::tag<api_version<2, 0>>;
+
+        heap_state_exception_handler()
+            : _state(1, 42)
+        { }
+
+        template < typename Func_, typename... Args_ >
+        void handle_exceptions(Func_&& func, Args_&&... args) const
+        {
+            if (_state.at(0) != 42)
+                throw std::runtime_error("Accessing invalid heap_state_exception_handler!");
+            func(std::forward<Args_>(args)...);
+        }
+    };
+
+    class exception_counter
+    {
+    private:
+        std::atomic<int>*   _counter;
+
+    public:
+        using tag = exception_handling::tag<api_version<2, 0>>;
+
+        explicit exception_counter(std::atomic<int>& counter)
+            : _counter(&counter)
+        { }
+
+        template < typename Func_, typename... Args_ >
+        void handle_exceptions(Func_&& func, Args_&&... args) const
+        {
+            try
+            { func(std::forward<Args_>(args)...); }
+            catch (const std::exception&)
+            { ++*_counter; }
+        }
+    };
+
 public:
     static void test_signals()
     {
@@ -288,8 +349,419 @@ public:
         }
     }
 
+    static void test_queued_emission()
+    {
+        token_pool tp;
+
+        std::vector<std::string> log;
+        signal<void(int)> a(signal_attributes::queued_emission), b(signal_attributes::queued_emission), c(signal_attributes::queued_emission);
+        tp += a.connect([&](int i) { log.push_back("a" + std::to_string(i)); b(i + 1); c(i + 1); log.push_back("a end"); });
+        tp += b.connect([&](int i) { log.push_back("b" + std::to_string(i)); c(i + 1); });
+        tp += c.connect([&](int i) { log.push_back("c" + std::to_string(i)); });
+
+        a(0);
+        std::vector<std::string> expected = { "a0", "a end", "b1", "c1", "c2" };
+        TS_ASSERT((log == expected));
+
+        log.clear();
+        b(0);
+        expected = { "b0", "c1" };
+        TS_ASSERT((log == expected));
+
+        int depth = 0, max_depth = 0, count = 0;
+        signal<void(int)> chain(signal_attributes::queued_emission);
+        tp += chain.connect([&](int i)
+            {
+                max_depth = std::max(max_depth, ++depth);
+                ++count;
+                if (i > 0)
+                    chain(i - 1);
+                --depth;
+            });
+        chain(100000);
+        TS_ASSERT_EQUALS(count, 100001);
+        TS_ASSERT_EQUALS(max_depth, 1);
+    }
+
+    static void test_concurrent_connect()
+    {
+        const int threads_count = 4, handlers_count = 1000;
+
+        signal<void(int)> s;
+        std::atomic<int> calls(0), disconnected_calls(0);
+        std::vector<token_pool> tps(threads_count);
+        {
+            std::vector<std::unique_ptr<thread>> threads;
+            for (int t = 0; t < threads_count; ++t)
+                threads.emplace_back(new thread([&, t](const std::atomic<bool>&)
+                    {
+                        for (int i = 0; i < handlers_count; ++i)
+                        {
+                            tps[t] += s.connect([&](int) { ++calls; });
+                            token(s.connect([&](int) { ++disconnected_calls; }));
+                        }
+                    }));
+            for (int i = 0; i < 100; ++i)
+                s(i);
+        }
+
+        calls = 0;
+        disconnected_calls = 0;
+        s(0);
+        TS_ASSERT_EQUALS(calls, threads_count * handlers_count);
+        TS_ASSERT_EQUALS(disconnected_calls, 0);
+
+        std::vector<int> order;
+        signal<void()> ordered;
+        token_pool tp;
+        for (int i = 0; i < 10; ++i)
+            tp += ordered.connect([&, i] { order.push_back(i); });
+        ordered();
+        TS_ASSERT((order == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }));
+    }
+
+    static void test_affine_signal()
+    {
+        struct counting_task_executor : public threadless_task_executor
+        {
+            std::atomic<int> tasks_count{0};
+
+            virtual void add_task(std::function<void()> task)
+            {
+                ++tasks_count;
+                threadless_task_executor::add_task(std::move(task));
+            }
+        };
+
+        {
+            auto worker = std::make_shared<counting_task_executor>();
+            const auto owner = std::this_thread::get_id();
+
+            std::vector<int> received;
+            bool wrong_thread = false;
+            auto handler = [&](int i) { received.push_back(i); wrong_thread = wrong_thread || std::this_thread::get_id() != owner; };
+
+            token_pool tp;
+            {
+                affine_signal<void(int)> s(worker);
+                for (int i = 0; i < 3; ++i)
+                    tp += s.connect(handler);
+
+                worker->add_task([&] {
+                        s(1);
+                        TS_ASSERT((received == std::vector<int>{ 1, 1, 1 }));
+                    });
+                worker->process_tasks();
+                TS_ASSERT_EQUALS(worker->tasks_count.load(), 1);
+
+                thread([&](const std::atomic<bool>&) { s(2); s(3); });
+                TS_ASSERT_EQUALS(received.size(), 3u);
+                TS_ASSERT_EQUALS(worker->tasks_count.load(), 3);
+
+                worker->process_tasks();
+                TS_ASSERT((received == std::vector<int>{ 1, 1, 1, 2, 2, 2, 3, 3, 3 }));
+                TS_ASSERT(!wrong_thread);
+
+                thread([&](const std::atomic<bool>&) { s(4); });
+            }
+
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(received.size(), 9u);
+        }
+
+        {
+            auto worker = std::make_shared<thread_task_executor>();
+            affine_signal<void(int)> s(worker);
+
+            std::mutex m;
+            std::vector<std::thread::id> handler_threads;
+            token t = s.connect([&](int) { auto l = lock(m); handler_threads.push_back(std::this_thread::get_id()); });
+
+            std::thread::id worker_thread;
+            bool synchronous = false;
+            std::promise<void> done;
+            s(1);
+            worker->add_task([&] {
+                    worker_thread = std::this_thread::get_id();
+                    s(2);
+                    auto l = lock(m);
+                    synchronous = handler_threads.size() == 2;
+                });
+            thread([&](const std::atomic<bool>&) { s(3); });
+            worker->add_task([&] { done.set_value(); });
+            done.get_future().wait();
+
+            TS_ASSERT(synchronous);
+            auto l = lock(m);
+            TS_ASSERT((handler_threads == std::vector<std::thread::id>(3, worker_thread)));
+        }
+    }
+
+    static void test_derived_signal()
+    {
+        signal<void(int)> s;
+
+        std::vector<std::string> received;
+        token t = derive(s).filter([](int i) { return i % 2 == 0; }).map([](int i) { return std::to_string(i); }).connect([&](const std::string& str) { received.push_back(str); });
+        for (int i = 0; i < 5; ++i)
+            s(i);
+        TS_ASSERT((received == std::vector<std::string>{ "0", "2", "4" }));
+        t.reset();
+        s(6);
+        TS_ASSERT_EQUALS(received.size(), 3u);
+
+        signal<void(int)> s2;
+        std::vector<int> merged;
+        int ticks = 0;
+        token tm = merge(derive(s).map([](int i) { return -i; }), derive(s2)).filter([](int i) { return i != 0; }).connect([&](int i) { merged.push_back(i); });
+        token tv = derive(s2.connector()).map([](int) { }).connect([&] { ++ticks; });
+        s(1);
+        s2(2);
+        s(0);
+        s2(3);
+        TS_ASSERT((merged == std::vector<int>{ -1, 2, 3 }));
+        TS_ASSERT_EQUALS(ticks, 2);
+
+        std::vector<int> throttled, unthrottled;
+        token tt1 = derive(s).throttle(hours(1)).connect([&](int i) { throttled.push_back(i); });
+        token tt2 = derive(s).throttle(nanoseconds(0)).connect([&](int i) { unthrottled.push_back(i); });
+        for (int i = 0; i < 3; ++i)
+            s(i);
+        TS_ASSERT((throttled == std::vector<int>{ 0 }));
+        TS_ASSERT((unthrottled == std::vector<int>{ 0, 1, 2 }));
+
+        int state = 10;
+        signal<void(int)> populated([&](const std::function<void(int)>& h) { h(state); });
+        std::vector<int> doubled;
+        token tp = derive(populated).map([](int i) { return i * 2; }).connect([&](int i) { doubled.push_back(i); });
+        populated(11);
+        TS_ASSERT((doubled == std::vector<int>{ 20, 22 }));
+    }
+
+    static std::vector<int> wait_for_values(std::mutex& m, const std::vector<int>& values, std::size_t count)
+    {
+        for (int i = 0; i < 200; ++i)
+        {
+            {
+                auto l = lock(m);
+                if (values.size() >= count)
+                    return values;
+            }
+            thread::sleep(10);
+        }
+        auto l = lock(m);
+        return values;
+    }
+
+    static void test_derived_signal_timing()
+    {
+        auto worker = std::make_shared<thread_task_executor>();
+        signal<void(int)> s;
+
+        {
+            std::mutex m;
+            std::vector<int> received;
+            token t = derive(s).debounce(milliseconds(100), worker).connect([&](int i) { auto l = lock(m); received.push_back(i); });
+
+            profiler p;
+            for (int i = 1; i <= 3; ++i)
+                s(i);
+            TS_ASSERT((wait_for_values(m, received, 1) == std::vector<int>{ 3 }));
+            TS_ASSERT_LESS_THAN_EQUALS(100, duration_cast<milliseconds>(p.reset()).count());
+
+            s(4);
+            t.reset();
+            thread::sleep(300);
+            auto l = lock(m);
+            TS_ASSERT((received == std::vector<int>{ 3 }));
+        }
+
+        {
+            std::mutex m;
+            std::vector<int> received;
+            token t = derive(s).sample(worker, milliseconds(100)).connect([&](int i) { auto l = lock(m); received.push_back(i); });
+
+            for (int i = 1; i <= 3; ++i)
+                s(i);
+            TS_ASSERT((wait_for_values(m, received, 1) == std::vector<int>{ 3 }));
+            thread::sleep(300);
+            TS_ASSERT((wait_for_values(m, received, 1) == std::vector<int>{ 3 }));
+
+            s(4);
+            TS_ASSERT((wait_for_values(m, received, 2) == std::vector<int>{ 3, 4 }));
+
+            t.reset();
+            s(5);
+            thread::sleep(300);
+            auto l = lock(m);
+            TS_ASSERT((received == std::vector<int>{ 3, 4 }));
+        }
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if WIGWAG_HAS_COROUTINES
+    static owned_coroutine await_emissions(const signal<void(int, const std::string&)>& s, std::vector<std::string>& received, int count, std::shared_ptr<task_executor> worker = nullptr)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            auto [n, str] = co_await s.next(worker);
+            received.push_back(std::to_string(n) + str);
+        }
+    }
+
+    static owned_coroutine await_connector_emission(signal_connector<void(int)> c, int& received)
+    { received = co_await c.next(); }
+
+    static owned_coroutine consume_stream(emission_stream<void(int)>& stream, std::vector<int>& received, int last)
+    {
+        for (int i = -1; i != last;)
+            received.push_back(i = co_await stream.next());
+    }
+#endif
+
+    static void test_signal_await()
+    {
+#if WIGWAG_HAS_COROUTINES
+        signal<void(int, const std::string&)> s;
+
+        {
+            std::vector<std::string> received;
+            owned_coroutine c = await_emissions(s, received, 2);
+            TS_ASSERT(!c.done());
+            s(1, "a");
+            TS_ASSERT((received == std::vector<std::string>{ "1a" }));
+            s(2, "b");
+            s(3, "c");
+            TS_ASSERT(c.done());
+            TS_ASSERT((received == std::vector<std::string>{ "1a", "2b" }));
+        }
+
+        {
+            auto worker = std::make_shared<threadless_task_executor>();
+            std::vector<std::string> received;
+            owned_coroutine c = await_emissions(s, received, 2, worker);
+            s(1, "a");
+            TS_ASSERT(received.empty());
+            worker->process_tasks();
+            TS_ASSERT((received == std::vector<std::string>{ "1a" }));
+            s(2, "b");
+            TS_ASSERT(!c.done());
+            worker->process_tasks();
+            TS_ASSERT(c.done());
+            TS_ASSERT((received == std::vector<std::string>{ "1a", "2b" }));
+        }
+
+        {
+            std::vector<std::string> received;
+            {
+                owned_coroutine c = await_emissions(s, received, 1);
+            }
+            s(1, "a");
+            TS_ASSERT(received.empty());
+        }
+
+        {
+            signal<void(int)> s2;
+            int received = 0;
+            owned_coroutine c = await_connector_emission(s2.connector(), received);
+            s2(42);
+            TS_ASSERT(c.done());
+            TS_ASSERT_EQUALS(received, 42);
+        }
+#endif
+    }
+
+    static void test_signal_stream()
+    {
+#if WIGWAG_HAS_COROUTINES
+        signal<void(int)> s;
+
+        {
+            auto stream = s.stream(4);
+            for (int i = 0; i < 6; ++i)
+                s(i);
+            TS_ASSERT_EQUALS(stream.get_dropped_count(), 2u);
+
+            std::vector<int> received;
+            owned_coroutine c = consume_stream(stream, received, 7);
+            TS_ASSERT((received == std::vector<int>{ 0, 1, 2, 3 }));
+            s(7);
+            TS_ASSERT(c.done());
+            TS_ASSERT((received == std::vector<int>{ 0, 1, 2, 3, 7 }));
+        }
+
+        {
+            auto stream = s.stream(4, stream_overflow::drop_oldest);
+            for (int i = 0; i < 6; ++i)
+                s(i);
+            TS_ASSERT_EQUALS(stream.get_dropped_count(), 2u);
+
+            std::vector<int> received;
+            owned_coroutine c = consume_stream(stream, received, 5);
+            TS_ASSERT(c.done());
+            TS_ASSERT((received == std::vector<int>{ 2, 3, 4, 5 }));
+        }
+
+        {
+            struct counting_task_executor : public threadless_task_executor
+            {
+                int tasks_count = 0;
+
+                virtual void add_task(std::function<void()> task)
+                {
+                    ++tasks_count;
+                    threadless_task_executor::add_task(std::move(task));
+                }
+            };
+
+            auto worker = std::make_shared<counting_task_executor>();
+            auto stream = s.stream(16, stream_overflow::drop_newest, worker);
+            std::vector<int> received;
+            owned_coroutine c = consume_stream(stream, received, 2);
+            s(0);
+            s(1);
+            s(2);
+            TS_ASSERT_EQUALS(worker->tasks_count, 1);
+            TS_ASSERT(received.empty());
+            worker->process_tasks();
+            TS_ASSERT(c.done());
+            TS_ASSERT((received == std::vector<int>{ 0, 1, 2 }));
+        }
+
+        {
+            const int count = 10000;
+            auto worker = std::make_shared<thread_task_executor>();
+            auto stream = s.stream(16, stream_overflow::drop_oldest, worker);
+            std::vector<int> received;
+
+            std::promise<void> started;
+            std::unique_ptr<owned_coroutine> c;
+            worker->add_task([&] { c.reset(new owned_coroutine(consume_stream(stream, received, count - 1))); started.set_value(); });
+            started.get_future().wait();
+
+            std::thread producer([&] {
+                    for (int i = 0; i < count; ++i)
+                        s(i);
+                });
+            producer.join();
+
+            while (true)
+            {
+                std::promise<bool> finished;
+                worker->add_task([&] { finished.set_value(c->done()); });
+                if (finished.get_future().get())
+                    break;
+                thread::sleep(10);
+            }
+
+            TS_ASSERT_EQUALS(received.size() + stream.get_dropped_count(), (size_t)count);
+            TS_ASSERT(std::is_sorted(received.begin(), received.end()));
+            TS_ASSERT_EQUALS(received.back(), count - 1);
+        }
+#endif
+    }
+
     static void test_handler_attributes()
     {
         using h_type = const std::function<void(int)>&;
@@ -490,6 +962,81 @@ public:
         TS_ASSERT_EQUALS(state.get(), 3);
     }
 
+    static void test__state_populating__snapshot_populator()
+    {
+        using h_type = const std::function<void(int)>&;
+        using state_ptr = std::shared_ptr<const std::vector<int>>;
+
+        state_ptr signal_state = std::make_shared<std::vector<int>>();
+        signal<void(int), state_populating::snapshot_populator> s([&]
+            {
+                state_ptr snapshot = signal_state;
+                return [snapshot](h_type h) { for (int i : *snapshot) { thread::sleep(1); h(i); } };
+            });
+
+        int emitted = 0;
+        auto emit = [&]
+            {
+                auto l = lock(s.lock_primitive());
+                auto new_state = std::make_shared<std::vector<int>>(*signal_state);
+                new_state->push_back(emitted);
+                signal_state = new_state;
+                s(emitted++);
+            };
+
+        for (int i = 0; i < 50; ++i)
+            emit();
+
+        std::mutex m;
+        std::vector<int> received;
+        int emitted_during_connect = 0;
+        {
+            thread th([&](const std::atomic<bool>& alive) { while (alive) { emit(); thread::sleep(1); } });
+
+            token t = s.connect([&](int i) { auto l = lock(m); received.push_back(i); });
+            {
+                auto l = lock(s.lock_primitive());
+                emitted_during_connect = emitted - 50;
+            }
+            thread::sleep(100);
+        }
+
+        TS_ASSERT_LESS_THAN(0, emitted_during_connect);
+        std::vector<int> expected;
+        for (int i = 0; i < emitted; ++i)
+            expected.push_back(i);
+        TS_ASSERT(received == expected);
+
+        struct counting_task_executor : public threadless_task_executor
+        {
+            int tasks_count = 0;
+
+            virtual void add_task(std::function<void()> task)
+            {
+                ++tasks_count;
+                threadless_task_executor::add_task(std::move(task));
+            }
+        };
+
+        auto worker = std::make_shared<counting_task_executor>();
+        std::vector<int> async_received;
+        token t = s.connect(worker, [&](int i) { async_received.push_back(i); });
+        TS_ASSERT_EQUALS(worker->tasks_count, 1);
+        emit();
+        expected.push_back(emitted - 1);
+        TS_ASSERT_EQUALS(worker->tasks_count, 2);
+        worker->process_tasks();
+        TS_ASSERT(async_received == expected);
+
+        std::vector<int> calls;
+        int calls_count = 0;
+        token t2 = s.connect([&calls, calls_count](int) mutable { calls.push_back(++calls_count); });
+        emit();
+        TS_ASSERT_EQUALS(calls.size(), (std::size_t)emitted);
+        for (std::size_t i = 0; i < calls.size(); ++i)
+            TS_ASSERT_EQUALS(calls[i], (int)i + 1);
+    }
+
     static void test__state_populating__none()
     {
         int signal_state = 0;
@@ -521,6 +1068,41 @@ public:
     static void test__life_assurance__intrusive_life_tokens()
     { do__test__life_assurance__common<signal<void(), exception_handling::default_, threading::default_, state_populating::default_, life_assurance::intrusive_life_tokens>>(); }
 
+    static void test__life_assurance__hazard_pointers()
+    { do__test__life_assurance__common<signal<void(), exception_handling::default_, threading::default_, state_populating::default_, life_assurance::hazard_pointers>>(); }
+
+    static void test__life_assurance__hazard_pointers__reclamation()
+    {
+        using wigwag::detail::hazard_pointer;
+        using wigwag::detail::hazard_pointers;
+
+        class counted
+        {
+            std::atomic<int>&   _destroyed;
+
+        public:
+            counted(std::atomic<int>& destroyed) : _destroyed(destroyed) { }
+            ~counted() { ++_destroyed; }
+        };
+
+        std::atomic<int> destroyed(0);
+        counted* obj = new counted(destroyed);
+        {
+            mutexed<bool> is_protected(false);
+            thread th([&](const std::atomic<bool>& alive) { hazard_pointer hp(obj); is_protected.set(true); while (alive) thread::sleep(10); });
+            while (!is_protected.get())
+                thread::sleep(10);
+
+            TS_ASSERT(hazard_pointers::is_protected_by_others(obj));
+            hazard_pointers::retire(obj);
+            hazard_pointers::reclaim();
+            TS_ASSERT_EQUALS(destroyed.load(), 0);
+        }
+
+        hazard_pointers::reclaim();
+        TS_ASSERT_EQUALS(destroyed.load(), 1);
+    }
+
     template < typename Signal_ >
     static void do__test__life_assurance__common()
     {
@@ -724,6 +1306,81 @@ public:
         }
     }
 
+    static void test__creation__embedded()
+    {
+        {
+            signal<void(), threading::none, life_assurance::single_threaded, creation::embedded> s;
+            s();
+            token t = s.connect([]{});
+            s();
+        }
+        {
+            listenable<test_listener, threading::none, life_assurance::single_threaded, creation::embedded> l;
+            l.invoke([](const test_listener& f) { f.f(); });
+            token t = l.connect(test_listener([] {}, [](int) {}));
+            l.invoke([](const test_listener& f) { f.f(); });
+        }
+        {
+            int counter = 0;
+            token t;
+            {
+                signal<void(), threading::none, life_assurance::single_threaded, creation::embedded> s;
+                t = s.connect([&]{ ++counter; });
+                s();
+            }
+            TS_ASSERT_EQUALS(counter, 1);
+            t.reset();
+        }
+        {
+            using h_type = const std::function<void(int)>&;
+
+            int counter = 0, withdrawn = 0;
+            token t;
+            {
+                signal<void(int), threading::none, life_assurance::single_threaded, state_populating::populator_and_withdrawer, creation::embedded> s(std::make_pair([](h_type h){ h(1); }, [&](h_type){ ++withdrawn; }));
+                token t2 = s.connect([&](int i) { counter += i; });
+                t = s.connector().connect([&](int i) { counter += 10 * i; });
+                s(2);
+                TS_ASSERT_EQUALS(counter, 33);
+            }
+            TS_ASSERT_EQUALS(withdrawn, 1);
+            t.reset();
+            TS_ASSERT_EQUALS(withdrawn, 2);
+        }
+        {
+            std::vector<int> calls;
+            bool connected = false;
+            token t0, t1, t2, t3;
+            {
+                signal<void(), heap_state_exception_handler, threading::none, life_assurance::single_threaded, creation::embedded> s;
+                t0 = s.connect([&]{ calls.push_back(0); });
+                t1 = s.connect([&]
+                    {
+                        calls.push_back(1);
+                        if (connected)
+                            return;
+                        connected = true;
+                        t3 = s.connector().connect([&]{ calls.push_back(3); });
+                        s.connector();
+                    });
+                t2 = s.connect([&]{ calls.push_back(2); });
+
+                s();
+                TS_ASSERT((calls == std::vector<int>{ 0, 1, 2 }));
+
+                calls.clear();
+                s();
+                TS_ASSERT((calls == std::vector<int>{ 0, 1, 2, 3 }));
+
+                t1.reset();
+                calls.clear();
+                s.connector();
+                s();
+                TS_ASSERT((calls == std::vector<int>{ 0, 2, 3 }));
+            }
+        }
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     static void test_life_token()
@@ -866,6 +1523,312 @@ public:
             TS_ASSERT_EQUALS(n, 3);
         }
 
+        {
+            std::atomic<int> exceptions(0);
+            {
+                basic_thread_task_executor<exception_counter> worker(std::ref(exceptions));
+                worker.add_task([] { throw std::runtime_error("Test exception"); });
+            }
+            {
+                basic_thread_task_executor<task_queue::drop_newest, exception_counter> worker(task_queue::args(2), std::ref(exceptions));
+                worker.add_task([] { throw std::runtime_error("Test exception"); });
+            }
+            TS_ASSERT_EQUALS(exceptions.load(), 2);
+        }
+
+    }
+
+    static void test_task_executor_is_current()
+    {
+        {
+            std::shared_ptr<task_executor> worker = std::make_shared<thread_task_executor>();
+            TS_ASSERT(!worker->is_current());
+
+            std::atomic<int> is_current(-1);
+            worker->add_task([&] { is_current = worker->is_current() ? 1 : 0; });
+            while (is_current == -1)
+                std::this_thread::yield();
+            TS_ASSERT_EQUALS(is_current, 1);
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            TS_ASSERT(!worker->is_current());
+
+            bool is_current = false;
+            worker->add_task([&] { is_current = worker->is_current(); });
+            worker->process_tasks();
+            TS_ASSERT(is_current);
+            TS_ASSERT(!worker->is_current());
+
+            bool is_current_on_other_thread = true;
+            std::thread([&] { is_current_on_other_thread = worker->is_current(); }).join();
+            TS_ASSERT(!is_current_on_other_thread);
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+
+            std::atomic<int> stage(0);
+            auto wait_for_stage = [&](int s) { while (stage < s) std::this_thread::yield(); };
+
+            bool first_is_current = false, second_is_current = false, first_is_current_after = true;
+            worker->add_task([&] { stage = 1; wait_for_stage(3); first_is_current = worker->is_current(); });
+            std::thread t1([&] { worker->process_tasks(); stage = 4; wait_for_stage(5); first_is_current_after = worker->is_current(); });
+            wait_for_stage(1);
+
+            worker->add_task([&] { stage = 2; wait_for_stage(4); second_is_current = worker->is_current(); });
+            std::thread t2([&] { worker->process_tasks(); stage = 5; });
+            wait_for_stage(2);
+
+            stage = 3;
+            t1.join();
+            t2.join();
+            TS_ASSERT(first_is_current);
+            TS_ASSERT(second_is_current);
+            TS_ASSERT(!first_is_current_after);
+        }
+    }
+
+    static void test_async_handler_inline_if_current()
+    {
+        struct counting_task_executor : public threadless_task_executor
+        {
+            int tasks_count = 0;
+
+            virtual void add_task(std::function<void()> task)
+            {
+                ++tasks_count;
+                threadless_task_executor::add_task(std::move(task));
+            }
+        };
+
+        auto worker = std::make_shared<counting_task_executor>();
+        signal<void(int)> s;
+
+        std::vector<int> queued, inlined;
+        token t1 = s.connect(worker, [&](int i) { queued.push_back(i); });
+        token t2 = s.connect(worker, [&](int i) { inlined.push_back(i); }, handler_attributes::inline_if_current);
+
+        s(1);
+        TS_ASSERT_EQUALS(worker->tasks_count, 2);
+        worker->process_tasks();
+
+        worker->tasks_count = 0;
+        worker->add_task([&] { s(2); });
+        worker->process_tasks();
+        TS_ASSERT_EQUALS(worker->tasks_count, 2);
+        worker->process_tasks();
+        TS_ASSERT((queued == std::vector<int>{ 1, 2 }));
+        TS_ASSERT((inlined == std::vector<int>{ 1, 2 }));
+
+        std::thread([&] { s(3); }).join();
+        TS_ASSERT_EQUALS(worker->tasks_count, 4);
+        worker->process_tasks();
+        TS_ASSERT((inlined == std::vector<int>{ 1, 2, 3 }));
+
+        s(4);
+        TS_ASSERT_EQUALS(worker->tasks_count, 6);
+        worker->process_tasks();
+        TS_ASSERT((inlined == std::vector<int>{ 1, 2, 3, 4 }));
+    }
+
+    static void test_task_executor_delayed_tasks()
+    {
+        auto worker = std::make_shared<thread_task_executor>();
+
+        std::mutex m;
+        std::vector<int> order;
+        std::vector<int64_t> delays;
+        const auto now = timed_task_executor::clock::now();
+        auto add = [&](int i) {
+                auto l = lock(m);
+                order.push_back(i);
+                delays.push_back(duration_cast<milliseconds>(timed_task_executor::clock::now() - now).count());
+            };
+
+        worker->add_task_at(now + milliseconds(200), [&] { add(2); });
+        worker->add_task_at(now + milliseconds(100), [&] { add(1); });
+        worker->add_task([&] { add(0); });
+        thread::sleep(500);
+
+        {
+            auto l = lock(m);
+            TS_ASSERT((order == std::vector<int>{ 0, 1, 2 }));
+            TS_ASSERT_LESS_THAN_EQUALS(100, delays[1]);
+            TS_ASSERT_LESS_THAN_EQUALS(200, delays[2]);
+        }
+
+        worker->add_task_at(timed_task_executor::clock::now() + hours(1), [&] { add(3); });
+        profiler p;
+        worker.reset();
+        TS_ASSERT_LESS_THAN(duration_cast<milliseconds>(p.reset()).count(), 1000);
+        TS_ASSERT_EQUALS(order.size(), 3u);
+
+        TS_ASSERT((run_delayed_tasks_on_full_worker(std::make_shared<basic_thread_task_executor<task_queue::drop_newest>>(task_queue::args(1))) == std::vector<int>{ 1, 2, 3, 0 }));
+        TS_ASSERT((run_delayed_tasks_on_full_worker(std::make_shared<basic_thread_task_executor<task_queue::coalesce>>(task_queue::args(1))) == std::vector<int>{ 1, 2, 3, 0 }));
+    }
+
+    template < typename Executor_ >
+    static std::vector<int> run_delayed_tasks_on_full_worker(std::shared_ptr<Executor_> worker)
+    {
+        std::mutex m;
+        std::atomic<bool> started(false);
+        std::vector<int> executed;
+
+        std::unique_lock<std::mutex> l(m);
+        worker->add_task([&] { started = true; auto g = lock(m); });
+        while (!started)
+            std::this_thread::yield();
+
+        worker->add_task([&executed] { executed.push_back(0); });
+        for (int i = 1; i <= 3; ++i)
+            worker->add_task_at(timed_task_executor::clock::now(), [&executed, i] { executed.push_back(i); });
+
+        thread::sleep(100);
+        l.unlock();
+        thread::sleep(200);
+        worker.reset();
+        return executed;
+    }
+
+    template < typename Executor_ >
+    static std::vector<int> add_tasks_to_busy_worker(std::shared_ptr<Executor_> worker, int count, task_queue_statistics& stats)
+    {
+        std::mutex m;
+        std::atomic<bool> started(false);
+        std::vector<int> executed;
+
+        std::unique_lock<std::mutex> l(m);
+        worker->add_task([&] { started = true; auto g = lock(m); });
+        while (!started)
+            std::this_thread::yield();
+
+        for (int i = 0; i < count; ++i)
+            worker->add_task([&executed, i] { executed.push_back(i); });
+
+        stats = worker->get_queue_statistics();
+        l.unlock();
+        worker.reset();
+        return executed;
+    }
+
+    static void test_bounded_task_queues()
+    {
+        using task = std::function<void()>;
+
+        {
+            task_queue_statistics stats;
+            auto executed = add_tasks_to_busy_worker(std::make_shared<basic_thread_task_executor<task_queue::unbounded>>(), 5, stats);
+            TS_ASSERT(executed == (std::vector<int>{ 0, 1, 2, 3, 4 }));
+            TS_ASSERT_EQUALS(stats.get_dropped_count(), 0u);
+        }
+
+        {
+            task_queue_statistics stats;
+            auto executed = add_tasks_to_busy_worker(std::make_shared<basic_thread_task_executor<task_queue::drop_newest>>(task_queue::args(2)), 5, stats);
+            TS_ASSERT(executed == (std::vector<int>{ 0, 1 }));
+            TS_ASSERT_EQUALS(stats.get_dropped_count(), 3u);
+        }
+
+        {
+            task_queue_statistics stats;
+            auto executed = add_tasks_to_busy_worker(std::make_shared<basic_thread_task_executor<task_queue::drop_oldest>>(task_queue::args(2)), 5, stats);
+            TS_ASSERT(executed == (std::vector<int>{ 3, 4 }));
+            TS_ASSERT_EQUALS(stats.get_dropped_count(), 3u);
+        }
+
+        {
+            task_queue_statistics stats;
+            auto executed = add_tasks_to_busy_worker(std::make_shared<basic_thread_task_executor<task_queue::coalesce>>(task_queue::args(2)), 5, stats);
+            TS_ASSERT(executed == (std::vector<int>{ 0, 4 }));
+            TS_ASSERT_EQUALS(stats.get_dropped_count(), 0u);
+            TS_ASSERT_EQUALS(stats.get_coalesced_count(), 3u);
+        }
+
+        {
+            task_queue_statistics stats;
+            auto merge = [](task queued, task incoming) -> task { return [=] { queued(); incoming(); }; };
+            auto executed = add_tasks_to_busy_worker(std::make_shared<basic_thread_task_executor<task_queue::coalesce>>(task_queue::args(2, merge)), 5, stats);
+            TS_ASSERT(executed == (std::vector<int>{ 0, 1, 2, 3, 4 }));
+            TS_ASSERT_EQUALS(stats.get_coalesced_count(), 3u);
+        }
+
+        {
+            auto worker = std::make_shared<basic_thread_task_executor<task_queue::block_producer>>(task_queue::args(1));
+
+            std::mutex m;
+            std::atomic<bool> started(false);
+            std::atomic<int> added(0);
+            std::vector<int> executed;
+
+            std::unique_lock<std::mutex> l(m);
+            worker->add_task([&] { started = true; auto g = lock(m); });
+            while (!started)
+                std::this_thread::yield();
+
+            std::thread producer([&] {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        worker->add_task([&executed, i] { executed.push_back(i); });
+                        ++added;
+                    }
+                });
+
+            thread::sleep(200);
+            TS_ASSERT_EQUALS(added.load(), 1);
+
+            l.unlock();
+            producer.join();
+            TS_ASSERT_EQUALS(worker->get_queue_statistics().get_dropped_count(), 0u);
+            worker.reset();
+            TS_ASSERT(executed == (std::vector<int>{ 0, 1, 2 }));
+        }
+    }
+
+    static void test_task_executor_instrumentation()
+    {
+        {
+            basic_threadless_task_executor<instrumentation::histograms> worker;
+
+            for (int i = 0; i < 3; ++i)
+                worker.add_task([]{ });
+            worker.add_task([]{ thread::sleep(50); });
+            worker.process_tasks();
+
+            task_executor_statistics stats = worker.get_task_statistics();
+            TS_ASSERT_EQUALS(stats.get_max_queue_depth(), 4u);
+            TS_ASSERT_EQUALS(stats.get_tasks_completed(), 4u);
+            TS_ASSERT_EQUALS(stats.get_wait_time().get_count(), 4u);
+            TS_ASSERT_EQUALS(stats.get_run_time().get_count(), 4u);
+            TS_ASSERT_LESS_THAN_EQUALS(50000000u, stats.get_run_time().get_max());
+            TS_ASSERT_LESS_THAN_EQUALS(50000000u, stats.get_run_time().get_percentile(1.0));
+            TS_ASSERT_LESS_THAN_EQUALS(stats.get_run_time().get_percentile(0.5), stats.get_run_time().get_percentile(1.0));
+        }
+
+        {
+            auto worker = std::make_shared<basic_thread_task_executor<instrumentation::histograms>>();
+
+            std::atomic<int> n(0);
+            for (int i = 0; i < 10; ++i)
+                worker->add_task([&]{ ++n; });
+
+            while (n < 10)
+                std::this_thread::yield();
+
+            task_executor_statistics stats = worker->get_task_statistics();
+            TS_ASSERT_LESS_THAN_EQUALS(1u, stats.get_max_queue_depth());
+            TS_ASSERT_LESS_THAN_EQUALS(9u, stats.get_tasks_completed());
+        }
+
+        {
+            for (uint64_t v : { 0ull, 7ull, 8ull, 15ull, 16ull, 1000ull, 123456789ull })
+            {
+                std::size_t i = histogram_snapshot::bucket_index(v);
+                TS_ASSERT_LESS_THAN_EQUALS(histogram_snapshot::bucket_lower_bound(i), v);
+                TS_ASSERT_LESS_THAN_EQUALS(v, histogram_snapshot::bucket_upper_bound(i));
+            }
+        }
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -993,8 +1956,416 @@ public:
             t.reset();
             TS_ASSERT_EQUALS(counter.load(), 2);
         }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            std::atomic<int> counter(0);
+            signal<void(const copy_ctor_counter&)> s;
+
+            token t1 = s.connect(worker, [](const copy_ctor_counter& c) { c(); });
+            token t2 = s.connect(worker, [](const copy_ctor_counter& c) { c(); });
+            token t3 = s.connect(worker, [](const copy_ctor_counter& c) { c(); });
+            s(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 1);
+            s(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 2);
+            worker->process_tasks();
+            TS_ASSERT_EQUALS(counter.load(), 2);
+        }
+
+        {
+            std::shared_ptr<threadless_task_executor> worker = std::make_shared<threadless_task_executor>();
+            std::atomic<int> counter(0);
+            signal<void(copy_ctor_counter&)> s;
+
+            token t1 = s.connect(worker, [](copy_ctor_counter& c) { c(); });
+            token t2 = s.connect(worker, [](copy_ctor_counter& c) { c(); });
+            copy_ctor_counter c(counter);
+            s(c);
+            TS_ASSERT_EQUALS(counter.load(), 2);
+            worker->process_tasks();
+        }
+#endif
+    }
+
+    static void test_signal_profiling()
+    {
+        {
+            signal<void(int), profiling::basic_sampling<1>> s;
+            token t1 = s.connect([](int) { thread::sleep(5); });
+            token t2 = s.connect([](int) { });
+
+            for (int i = 0; i < 3; ++i)
+                s(i);
+
+            std::vector<signal_profiling_snapshot> profiles = get_signal_profiling_snapshots();
+            TS_ASSERT_EQUALS(profiles.size(), 1u);
+            const signal_profiling_snapshot& p = profiles.at(0);
+            TS_ASSERT_EQUALS(p.get_emit_count(), 3u);
+            TS_ASSERT_EQUALS(p.get_sampled_count(), 3u);
+            TS_ASSERT_EQUALS(p.get_handlers_count(), 2u);
+            TS_ASSERT_EQUALS(p.get_handlers().size(), 2u);
+            TS_ASSERT_EQUALS(p.get_handlers().at(0).get_calls(), 3u);
+            TS_ASSERT_LESS_THAN_EQUALS(p.get_handlers().at(1).get_total_ns(), p.get_handlers().at(0).get_total_ns());
+            TS_ASSERT_LESS_THAN_EQUALS(p.get_handlers().at(0).get_total_ns(), p.get_estimated_total_ns());
+
+            std::ostringstream report;
+            print_signal_profiling_report(report);
+            TS_ASSERT_DIFFERS(report.str().find("(int)>"), std::string::npos);
+        }
+
+        {
+            signal<void(), profiling::sampling> s;
+            token t = s.connect([] { });
+            for (int i = 0; i < 32; ++i)
+                s();
+
+            std::vector<signal_profiling_snapshot> profiles = get_signal_profiling_snapshots();
+            TS_ASSERT_EQUALS(profiles.size(), 1u);
+            TS_ASSERT_EQUALS(profiles.at(0).get_emit_count(), 32u);
+            TS_ASSERT_EQUALS(profiles.at(0).get_sampled_count(), 2u);
+        }
+
+        {
+            signal<void(), threading::none, life_assurance::single_threaded, profiling::basic_sampling<1>> s;
+            token t1 = s.connect([] { });
+            token t2;
+            t2 = s.connect([&] { t2.reset(); });
+            s();
+            TS_ASSERT_EQUALS(get_signal_profiling_snapshots().at(0).get_handlers().size(), 2u);
+
+            t1.reset();
+            s();
+            std::vector<handler_profiling_snapshot> handlers = get_signal_profiling_snapshots().at(0).get_handlers();
+            TS_ASSERT_EQUALS(handlers.size(), 2u);
+            TS_ASSERT_EQUALS(handlers.at(0).get_calls(), 1u);
+            TS_ASSERT_EQUALS(handlers.at(1).get_calls(), 1u);
+
+            token t3 = s.connect([] { });
+            s();
+            handlers = get_signal_profiling_snapshots().at(0).get_handlers();
+            TS_ASSERT_EQUALS(handlers.size(), 3u);
+            std::set<uint64_t> ids;
+            for (const auto& h : handlers)
+                ids.insert(h.get_id());
+            TS_ASSERT_EQUALS(ids.size(), 3u);
+        }
+
+        {
+            signal<void(), threading::none, life_assurance::single_threaded, creation::embedded, profiling::basic_sampling<1>> s;
+            token t = s.connect([] { thread::sleep(1); });
+            s();
+
+            signal_connector<void()> c = s.connector();
+            s();
+            std::vector<handler_profiling_snapshot> handlers = get_signal_profiling_snapshots().at(0).get_handlers();
+            TS_ASSERT_EQUALS(handlers.size(), 1u);
+            TS_ASSERT_EQUALS(handlers.at(0).get_calls(), 2u);
+        }
+
+        TS_ASSERT(get_signal_profiling_snapshots().empty());
+    }
+
+    static void test_chrome_trace_export()
+    {
+        {
+            tracing::scope s("outside");
+        }
+
+        tracing::start();
+        {
+            tracing::scope s("user \"scope\"");
+        }
+        tracing::stop();
+
+        std::ostringstream ss;
+        tracing::write_chrome_trace(ss);
+        std::string trace = ss.str();
+
+        TS_ASSERT_EQUALS(trace.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+        TS_ASSERT_EQUALS(trace.find("outside"), std::string::npos);
+        TS_ASSERT_DIFFERS(trace.find("\"name\":\"user \\\"scope\\\"\",\"cat\":\"wigwag\",\"ph\":\"B\""), std::string::npos);
+        TS_ASSERT_DIFFERS(trace.find("\"ph\":\"E\""), std::string::npos);
+
+        std::ostringstream ss2;
+        tracing::write_chrome_trace(ss2);
+        TS_ASSERT_EQUALS(ss2.str().find("user"), std::string::npos);
+
+        tracing::start();
+        std::thread([] { tracing::scope s("exited thread"); }).join();
+        tracing::stop();
+
+        std::ostringstream ss3;
+        tracing::write_chrome_trace(ss3);
+        TS_ASSERT_DIFFERS(ss3.str().find("exited thread"), std::string::npos);
+
+        std::ostringstream ss4;
+        tracing::write_chrome_trace(ss4);
+        TS_ASSERT_EQUALS(ss4.str().find("exited thread"), std::string::npos);
+    }
+
+    static void test_signal_emit_move()
+    {
+#if !HAS_STD_FUNCTION_MOVE_BUG
+        {
+            std::atomic<int> counter(0);
+            signal<void(copy_ctor_counter)> s;
+
+            token t1 = s.connect([](copy_ctor_counter c) { c(); });
+            token t2 = s.connect([](copy_ctor_counter c) { c(); });
+            s(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 2);
+            s.emit_move(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 3);
+
+            token t3 = s.connect([](copy_ctor_counter c) { c(); });
+            t3.reset();
+            s.emit_move(copy_ctor_counter(counter));
+            TS_ASSERT_EQUALS(counter.load(), 4);
+        }
+
+        {
+            std::atomic<int> counter(0);
+            signal<void(const copy_ctor_counter&)> s;
+
+            copy_ctor_counter c(counter);
+            token t1 = s.connect([](const copy_ctor_counter& x) { x(); });
+            token t2 = s.connect([](const copy_ctor_counter& x) { x(); });
+            s.emit_move(c);
+            c();
+            TS_ASSERT_EQUALS(counter.load(), 0);
+        }
+
+        {
+            std::vector<std::string> received;
+            signal<void(std::string)> s;
+
+            token t1 = s.connect([&](std::string str) { received.push_back(std::move(str)); });
+            token t2 = s.connect([&](std::string str) { received.push_back(std::move(str)); });
+            s.emit_move(std::string(100, 'a'));
+            TS_ASSERT_EQUALS(received.size(), 2u);
+            TS_ASSERT_EQUALS(received[0], std::string(100, 'a'));
+            TS_ASSERT_EQUALS(received[1], std::string(100, 'a'));
+        }
 #endif
     }
+
+    static void test_observable_vector()
+    {
+        using namespace wigwag::observable;
+        using vec = observable_vector<int>;
+
+        vec v { 1, 2, 3 };
+        std::vector<int> mirror;
+        int change_sets = 0;
+
+        token t = v.connect([&](const vec::change_set_type& cs)
+            {
+                ++change_sets;
+                TS_ASSERT_EQUALS(cs.get_previous().size(), mirror.size());
+                for (const auto& c : cs.get_changes())
+                {
+                    auto pos = mirror.begin() + static_cast<std::ptrdiff_t>(c.get_index());
+                    switch (c.get_kind())
+                    {
+                    case change_kind::reset:
+                        mirror.assign(c.get_new_items().begin(), c.get_new_items().end());
+                        break;
+                    case change_kind::inserted:
+                        mirror.insert(pos, c.get_new_items().begin(), c.get_new_items().end());
+                        break;
+                    case change_kind::removed:
+                        mirror.erase(pos, pos + static_cast<std::ptrdiff_t>(c.get_old_items().size()));
+                        break;
+                    case change_kind::updated:
+                        std::copy(c.get_new_items().begin(), c.get_new_items().end(), pos);
+                        break;
+                    }
+                }
+                TS_ASSERT(std::equal(mirror.begin(), mirror.end(), cs.get_current().begin()));
+            });
+
+        TS_ASSERT(mirror == std::vector<int>({ 1, 2, 3 }));
+        vec::snapshot_type initial = v.get_snapshot();
+
+        v.push_back(4);
+        v.insert(0, 0);
+        std::vector<int> items = { 7, 8, 9 };
+        v.insert(2, items.begin(), items.end());
+        TS_ASSERT(mirror == std::vector<int>({ 0, 1, 7, 8, 9, 2, 3, 4 }));
+
+        v.erase(1, 2);
+        v.set(0, 42);
+        TS_ASSERT(mirror == std::vector<int>({ 42, 8, 9, 2, 3, 4 }));
+        TS_ASSERT_EQUALS(v.at(1), 8);
+        TS_ASSERT_EQUALS(change_sets, 6);
+
+        v.clear();
+        TS_ASSERT(mirror.empty());
+        TS_ASSERT(v.empty());
+
+        v.assign(items.begin(), items.end());
+        TS_ASSERT(mirror == items);
+        TS_ASSERT(std::vector<int>(initial.begin(), initial.end()) == std::vector<int>({ 1, 2, 3 }));
+
+        vector_snapshot<int> snapshot = v.get_snapshot().slice(1, 2);
+        TS_ASSERT(std::vector<int>(snapshot.begin(), snapshot.end()) == std::vector<int>({ 8, 9 }));
+        TS_ASSERT_THROWS_ANYTHING(snapshot.at(2));
+        TS_ASSERT_THROWS_ANYTHING(v.erase(2, 2));
+    }
+
+    static void test_observable_map()
+    {
+        using namespace wigwag::observable;
+        using map = observable_map<std::string, int>;
+
+        map m;
+        m.set("a", 1);
+
+        std::map<std::string, int> mirror;
+        std::vector<change_kind> kinds;
+        token t = m.connect([&](const map::change_set_type& cs)
+            {
+                for (const auto& c : cs.get_changes())
+                {
+                    kinds.push_back(c.get_kind());
+                    if (c.get_kind() == change_kind::reset)
+                        mirror = std::map<std::string, int>(cs.get_current().begin(), cs.get_current().end());
+                    else if (c.has_new_value())
+                        mirror[c.get_key()] = c.get_new_value();
+                    else
+                        mirror.erase(c.get_key());
+                }
+            });
+
+        m.set("b", 2);
+        m.set("a", 3);
+        TS_ASSERT(!m.erase("c"));
+        TS_ASSERT(m.erase("b"));
+        std::map<std::string, int> batch = { { "x", 1 }, { "y", 2 } };
+        m.insert(batch.begin(), batch.end());
+
+        TS_ASSERT((mirror == std::map<std::string, int>({ { "a", 3 }, { "x", 1 }, { "y", 2 } })));
+        TS_ASSERT(kinds == std::vector<change_kind>({ change_kind::reset, change_kind::inserted, change_kind::updated, change_kind::removed, change_kind::inserted, change_kind::inserted }));
+
+        map::snapshot_type snapshot = m.get_snapshot();
+        m.clear();
+        TS_ASSERT(mirror.empty());
+        TS_ASSERT_EQUALS(snapshot.size(), 3u);
+        TS_ASSERT_EQUALS(snapshot.at("x"), 1);
+        TS_ASSERT(!snapshot.find("b"));
+        TS_ASSERT_EQUALS(snapshot.begin()->first, "a");
+    }
+
+    static void test_observable_unordered_map()
+    {
+        using namespace wigwag::observable;
+
+        struct colliding_hash
+        {
+            std::size_t operator()(int x) const { return static_cast<std::size_t>(x % 3); }
+        };
+        using map = observable_unordered_map<int, int, colliding_hash>;
+
+        map m;
+        std::map<int, int> mirror;
+        token t = m.connect([&](const map::change_set_type& cs)
+            {
+                for (const auto& c : cs.get_changes())
+                {
+                    if (c.get_kind() == change_kind::reset)
+                        mirror = std::map<int, int>(cs.get_current().begin(), cs.get_current().end());
+                    else if (c.has_new_value())
+                        mirror[c.get_key()] = c.get_new_value();
+                    else
+                        mirror.erase(c.get_key());
+                }
+            });
+
+        for (int i = 0; i < 100; ++i)
+            m.set(i, i);
+        for (int i = 0; i < 100; i += 2)
+            m.erase(i);
+        for (int i = 1; i < 100; i += 4)
+            m.set(i, -i);
+
+        map::snapshot_type snapshot = m.get_snapshot();
+        TS_ASSERT_EQUALS(snapshot.size(), 50u);
+        TS_ASSERT((mirror == std::map<int, int>(snapshot.begin(), snapshot.end())));
+        for (int i = 0; i < 100; ++i)
+        {
+            TS_ASSERT_EQUALS(snapshot.contains(i), i % 2 == 1);
+            if (i % 2 == 1)
+                TS_ASSERT_EQUALS(*snapshot.find(i), i % 4 == 1 ? -i : i);
+        }
+    }
+
+    static void test_observable_batch_update()
+    {
+        using namespace wigwag::observable;
+
+        {
+            using vec = observable_vector<int>;
+            vec v { 1, 2, 3 };
+            std::vector<vec::change_set_type> change_sets;
+            token t = v.connect([&](const vec::change_set_type& cs) { change_sets.push_back(cs); });
+            change_sets.clear();
+
+            {
+                update_scope<vec> s(v);
+                for (int i = 0; i < 5; ++i)
+                    v.push_back(10 + i);
+                v.set(4, 99);
+                v.erase(5);
+                TS_ASSERT(change_sets.empty());
+            }
+
+            TS_ASSERT_EQUALS(change_sets.size(), 1u);
+            const auto& changes = change_sets[0].get_changes();
+            TS_ASSERT_EQUALS(changes.size(), 1u);
+            TS_ASSERT(changes[0].get_kind() == change_kind::inserted);
+            TS_ASSERT_EQUALS(changes[0].get_index(), 3u);
+            TS_ASSERT(std::vector<int>(changes[0].get_new_items().begin(), changes[0].get_new_items().end()) == std::vector<int>({ 10, 99, 13, 14 }));
+            TS_ASSERT_EQUALS(change_sets[0].get_previous().size(), 3u);
+
+            v.begin_update();
+            v.begin_update();
+            v.push_back(1);
+            v.end_update();
+            v.erase(v.size() - 1);
+            v.end_update();
+            TS_ASSERT_EQUALS(change_sets.size(), 1u);
+        }
+
+        {
+            using map = observable_map<int, int>;
+            map m;
+            m.set(1, 1);
+            m.set(2, 2);
+
+            std::vector<std::pair<change_kind, int>> changes;
+            token t = m.connect([&](const map::change_set_type& cs)
+                {
+                    for (const auto& c : cs.get_changes())
+                        if (c.get_kind() != change_kind::reset)
+                            changes.push_back(std::make_pair(c.get_kind(), c.get_key()));
+                });
+
+            {
+                update_scope<map> s(m);
+                m.erase(1);
+                m.set(1, 5);
+                m.set(3, 3);
+                m.erase(3);
+                m.set(2, 7);
+                m.set(2, 8);
+                m.set(4, 4);
+            }
+
+            TS_ASSERT((changes == std::vector<std::pair<change_kind, int>>({ { change_kind::updated, 1 }, { change_kind::updated, 2 }, { change_kind::inserted, 4 } })));
+            TS_ASSERT_EQUALS(m.at(2), 8);
+        }
+    }
 };
 
 
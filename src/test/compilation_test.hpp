@@ -8,7 +8,11 @@
 // WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 
+#include <wigwag/affine_signal.hpp>
 #include <wigwag/listenable.hpp>
+#include <wigwag/observable/observable_map.hpp>
+#include <wigwag/observable/observable_unordered_map.hpp>
+#include <wigwag/observable/observable_vector.hpp>
 #include <wigwag/signal.hpp>
 #include <wigwag/thread_task_executor.hpp>
 #include <wigwag/threadless_task_executor.hpp>
@@ -113,6 +117,9 @@ public:
         on_func(std::bind([](const std::string&, int){ }, "qwe", std::placeholders::_1));
         on_string_ref(s);
         on_string_ref(std::ref(s));
+
+        on_func.emit_move([](int){ });
+        on_string_ref.emit_move(s);
     }
 
 private:
@@ -128,19 +135,47 @@ public:
     wigwag::signal<void(), wigwag::threading::shared_recursive_mutex> s2;
     wigwag::signal<void(), wigwag::life_assurance::none, wigwag::state_populating::none> s3;
     wigwag::signal<void(), wigwag::threading::shared_recursive_mutex, wigwag::creation::lazy> s4;
+    wigwag::signal<void(), wigwag::threading::none, wigwag::life_assurance::single_threaded, wigwag::creation::embedded> s5;
+    wigwag::signal<void(), wigwag::profiling::sampling> s6;
+    wigwag::signal<void(int), wigwag::state_populating::snapshot_populator> s7;
+    wigwag::affine_signal<void(const std::string&), wigwag::life_assurance::hazard_pointers> s8;
 
     wigwag::listenable<std::function<void()>, wigwag::exception_handling::none> l1;
     wigwag::listenable<std::function<void()>, wigwag::threading::shared_recursive_mutex> l2;
     wigwag::listenable<std::function<void()>, wigwag::life_assurance::none, wigwag::state_populating::none> l3;
 
+    wigwag::basic_thread_task_executor<wigwag::task_queue::block_producer> e1;
+    wigwag::basic_thread_task_executor<wigwag::exception_handling::none, wigwag::task_queue::drop_oldest> e2;
+    wigwag::basic_thread_task_executor<wigwag::task_queue::drop_newest> e3;
+    wigwag::basic_thread_task_executor<wigwag::task_queue::coalesce> e4;
+    wigwag::basic_thread_task_executor<wigwag::instrumentation::histograms, wigwag::task_queue::drop_oldest> e5;
+    wigwag::basic_threadless_task_executor<wigwag::instrumentation::histograms, wigwag::threading::none> e6;
+
+    wigwag::observable::observable_vector<int, wigwag::exception_handling::none> o1;
+    wigwag::observable::observable_map<std::string, int> o2;
+    wigwag::observable::observable_unordered_map<int, std::string, std::hash<int>, std::equal_to<int>, wigwag::life_assurance::single_threaded> o3;
+
     instantiations_test()
         :   s1(),
             s2(std::make_shared<std::recursive_mutex>()),
             s3(),
             s4(std::make_shared<std::recursive_mutex>()),
+            s5(),
+            s6(),
+            s7([]{ return [](const std::function<void(int)>& h) { h(0); }; }),
+            s8(std::make_shared<wigwag::threadless_task_executor>()),
             l1(),
             l2(std::make_shared<std::recursive_mutex>()),
-            l3()
+            l3(),
+            e1(wigwag::task_queue::args(16)),
+            e2(wigwag::task_queue::args(16)),
+            e3(wigwag::task_queue::args(16)),
+            e4(wigwag::task_queue::args(16)),
+            e5(wigwag::task_queue::args(16)),
+            e6(),
+            o1(),
+            o2(),
+            o3()
     { }
 
     void f()
@@ -149,9 +184,33 @@ public:
         s2.connect([]{});
         s3.connect([]{});
         s4.connect([]{});
+        s5.connect([]{});
+        s6.connect([]{});
+        s7.connect([](int){});
+        s8.connect([](const std::string&){});
+        s8("qwe");
         l1.connect([]{});
         l2.connect([]{});
         l3.connect([]{});
+        e1.add_task([]{});
+        e2.add_task([]{});
+        e3.add_task([]{});
+        e4.add_task([]{});
+        e5.add_task([]{});
+        e6.add_task([]{});
+        e6.process_tasks();
+        e5.get_task_statistics().get_wait_time().get_percentile(0.99);
+        e6.get_task_statistics().get_run_time().get_mean();
+        o1.push_back(1);
+        o1.connect([](const decltype(o1)::change_set_type& cs){ cs.get_current().size(); });
+        o2.set("a", 1);
+        o2.on_changed().connect([](const decltype(o2)::change_set_type& cs){ cs.get_changes().front().get_key(); });
+        o3.set(1, "a");
+        o3.connect([](const decltype(o3)::change_set_type& cs){ cs.get_previous().find(1); });
+        {
+            wigwag::observable::update_scope<decltype(o2)> s(o2);
+            o2.erase("a");
+        }
     }
 
     void f() const
@@ -160,6 +219,8 @@ public:
         s2();
         s3();
         s4();
+        s5();
+        s6();
         l1.invoke([](const std::function<void()>& f){ f(); });
         l2.invoke([](const std::function<void()>& f){ f(); });
         l3.invoke([](const std::function<void()>& f){ f(); });
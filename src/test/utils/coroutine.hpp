@@ -0,0 +1,62 @@
+#ifndef UTILS_COROUTINE_HPP
+#define UTILS_COROUTINE_HPP
+
+// Copyright (c) 2016, Dmitry Koplyarov <koplyarov.da@gmail.com>
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose with or without fee is hereby granted,
+// provided that the above copyright notice and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS,
+// WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#include <wigwag/detail/config.hpp>
+
+#if WIGWAG_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+
+
+namespace wigwag
+{
+
+    // Starts right away and keeps the frame until it is destroyed, so the tests may check whether it has finished
+    class owned_coroutine
+    {
+    public:
+        struct promise_type
+        {
+            owned_coroutine get_return_object() { return owned_coroutine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() { }
+            void unhandled_exception() { std::terminate(); }
+        };
+
+    private:
+        std::coroutine_handle<promise_type>     _handle;
+
+    public:
+        explicit owned_coroutine(std::coroutine_handle<promise_type> handle)
+            : _handle(handle)
+        { }
+
+        ~owned_coroutine()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+
+        owned_coroutine(const owned_coroutine&) = delete;
+        owned_coroutine& operator = (const owned_coroutine&) = delete;
+
+        bool done() const { return _handle.done(); }
+    };
+
+}
+
+#endif
+
+#endif